@@ -61,18 +61,16 @@ void setup()
   Serial.print(F("I2C session is "));
   Serial.println(tag.isI2CSessionOpen() ? "opened." : "closed.");
 
-  Serial.println(F("Configuring GPO1 to toggle on field change only."));
-  tag.setGPO1Bit(BIT_GPO1_FIELD_CHANGE_EN, true);
-  Serial.println(F("Disabling other bits."));
-  tag.setGPO1Bit(BIT_GPO1_RF_USER_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_RF_ACTIVITY_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_RF_INTERRUPT_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_RF_PUT_MSG_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_RF_GET_MSG_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_RF_WRITE_EN, false);
-
-  Serial.println(F("Enabling GPO_EN bit."));
-  tag.setGPO1Bit(BIT_GPO1_GPO_EN, true);
+  Serial.println(F("Configuring GPO1 to toggle on field change only, disabling other bits and enabling GPO_EN."));
+  // All eight GPO1 bits are written with a single I2C write
+  tag.modifyFields(FIELD_GPO1_GPO_EN(true),
+                   FIELD_GPO1_FIELD_CHANGE_EN(true),
+                   FIELD_GPO1_RF_USER_EN(false),
+                   FIELD_GPO1_RF_ACTIVITY_EN(false),
+                   FIELD_GPO1_RF_INTERRUPT_EN(false),
+                   FIELD_GPO1_RF_PUT_MSG_EN(false),
+                   FIELD_GPO1_RF_GET_MSG_EN(false),
+                   FIELD_GPO1_RF_WRITE_EN(false));
   // Note: the GPO Control Dynamic Bit can be set or cleared at any time
   //tag.setGPO_CTRL_DynBit(false); // This will disable GPO even when I2C security is closed
 }
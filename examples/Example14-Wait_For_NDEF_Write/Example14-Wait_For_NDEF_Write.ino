@@ -15,6 +15,7 @@
   We think the App is doing a read-modify-write using separate RF transactions and gets confused if the tag
   becomes busy with an I2C transaction part way through.
   We've found that using the GPO pin to indicate RF activity and delay the next I2C transaction is a good work-around.
+  When setup() writes to the tag memory, it uses an exclusive window which puts RF to sleep until the writes are complete.
   Uncomment the "#define useGPOpin" below if you want to use the GPO pin to delay I2C activity.
   
   The ST25PC-NFC (Windows) software seems much more robust. But you need a separate reader (e.g. ST25R3911B-DISCO) to use that.
@@ -87,45 +88,51 @@ void setup()
 
   // -=-=-=-=-=-=-=-=-
 
-  Serial.println(F("Configuring GPO1 to indicate RF user & activity."));
-  tag.setGPO1Bit(BIT_GPO1_RF_USER_EN, true);
-  tag.setGPO1Bit(BIT_GPO1_RF_ACTIVITY_EN, true);
-  
-  Serial.println(F("Disabling other bits."));
-  tag.setGPO1Bit(BIT_GPO1_RF_INTERRUPT_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_FIELD_CHANGE_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_RF_PUT_MSG_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_RF_GET_MSG_EN, false);
-  tag.setGPO1Bit(BIT_GPO1_RF_WRITE_EN, false);
-
-  // -=-=-=-=-=-=-=-=-
-
-  Serial.println(F("Enabling GPO_EN bit."));
-  tag.setGPO1Bit(BIT_GPO1_GPO_EN, true);
+  Serial.println(F("Configuring GPO1 to indicate RF user & activity, disabling other bits and enabling GPO_EN."));
+  // All eight GPO1 bits are written with a single I2C write
+  tag.modifyFields(FIELD_GPO1_GPO_EN(true),
+                   FIELD_GPO1_RF_USER_EN(true),
+                   FIELD_GPO1_RF_ACTIVITY_EN(true),
+                   FIELD_GPO1_RF_INTERRUPT_EN(false),
+                   FIELD_GPO1_FIELD_CHANGE_EN(false),
+                   FIELD_GPO1_RF_PUT_MSG_EN(false),
+                   FIELD_GPO1_RF_GET_MSG_EN(false),
+                   FIELD_GPO1_RF_WRITE_EN(false));
 
 #endif
 
   // -=-=-=-=-=-=-=-=-
 
-  // Clear the first 256 bytes of user memory
-  uint8_t tagMemory[256];
-  memset(tagMemory, 0, 256);
+  // Put RF to sleep while the memory is cleared and the CC File and empty record are written,
+  // so a phone can not read the memory half-written. RF is restored when window goes out of scope
+  {
+    SFE_ST25DV64KC_ExclusiveWindow window(tag);
+
+    // Clear the first 256 bytes of user memory
+    uint8_t tagMemory[256];
+    memset(tagMemory, 0, 256);
 
-  Serial.println("Writing 0x0 to the first 256 bytes of user memory.");
-  tag.writeEEPROM(0x0, tagMemory, 256);
+    Serial.println("Writing 0x0 to the first 256 bytes of user memory.");
+    tag.writeEEPROM(0x0, tagMemory, 256);
 
-  // -=-=-=-=-=-=-=-=-
+    // -=-=-=-=-=-=-=-=-
 
-  // Write the Type 5 CC File - eight bytes - starting at address zero
-  Serial.println(F("Writing CC_File"));
-  tag.writeCCFile8Byte();
+    // Write the Type 5 CC File - eight bytes - starting at address zero
+    Serial.println(F("Writing CC_File"));
+    tag.writeCCFile8Byte();
 
-  // -=-=-=-=-=-=-=-=-
+    // -=-=-=-=-=-=-=-=-
 
-  // Add an empty record at the first memory location after the CC File
-  Serial.println(F("Writing an empty (zero-length) TLV Record"));
-  uint16_t memoryLocation = tag.getCCFileLen(); // Write to the memory location immediately after the CC File
-  tag.writeNDEFEmpty(&memoryLocation);
+    // Add an empty record at the first memory location after the CC File
+    Serial.println(F("Writing an empty (zero-length) TLV Record"));
+    uint16_t memoryLocation = tag.getCCFileLen(); // Write to the memory location immediately after the CC File
+    tag.writeNDEFEmpty(&memoryLocation);
+
+    window.release(); // Restore RF now so we can print how long it was asleep
+    Serial.print(F("RF was asleep for "));
+    Serial.print(window.getHeldTime());
+    Serial.println(F("us"));
+  }
 
   // -=-=-=-=-=-=-=-=-
 
@@ -0,0 +1,116 @@
+/*
+  ST25DV64KC Example
+  SparkFun Electronics
+  License: MIT. Please see the license file for more information but you can
+  basically do whatever you want with this code.
+
+  This example compares two ways of disabling and enabling RF:
+  * The RF_SWITCH_OFF / RF_SWITCH_ON device select codes (rfSwitchOff / rfSwitchOn):
+    a single I2C transaction with no register address or data
+  * The RF_DISABLE bit in the RF_MNGT_Dyn register (setField<FIELD_RF_MNGT_DYN_RF_DISABLE>):
+    a register read-modify-write
+  
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+  SparkFun Qwiic RFID Tag - ST25DV64KC : https://www.sparkfun.com/products/19035
+
+  Hardware Connections:
+  Plug a Qwiic cable into the Qwiic RFID Tag and a RedBoard
+  If you don't have a platform with a Qwiic connection use the SparkFun Qwiic Breadboard Jumper (https://www.sparkfun.com/products/14425)
+  Open the serial monitor at 115200 baud to see the output
+*/
+
+#include <SparkFun_ST25DV64KC_Arduino_Library.h> // Click here to get the library:  http://librarymanager/All#SparkFun_ST25DV64KC
+
+SFE_ST25DV64KC tag;
+
+const uint16_t cycles = 100; // Number of disable + enable cycles to time
+
+void setup()
+{
+  delay(1000);
+
+  Serial.begin(115200);
+  Wire.begin();
+
+  Serial.println(F("ST25DV64KC example."));
+
+  if (!tag.begin(Wire))
+  {
+    Serial.println(F("ST25 not detected. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  Serial.println(F("ST25 connected."));
+
+  // -=-=-=-=-=-=-=-=-
+
+  // The tag ignores the RF_SWITCH device select codes until RF_SWITCHOFF_EN in I2C_CFG is set.
+  // I2C_CFG is a static register, so it can only be changed during an open security session.
+  // Storing the password lets the library open the session when it needs to
+  uint8_t password[8] = {0x0};
+  tag.setI2CSessionPassword(password);
+
+  if (!tag.setRFSwitchEnabled(true))
+  {
+    Serial.println(F("Could not set RF_SWITCHOFF_EN. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  // Check that the device select codes really do switch RF. They change RF_OFF, not RF_DISABLE
+  tag.rfSwitchOff();
+  Serial.print(F("After rfSwitchOff, RF_OFF is "));
+  Serial.println(tag.getField<FIELD_RF_MNGT_DYN_RF_OFF>() ? "set." : "clear.");
+
+  tag.rfSwitchOn();
+  Serial.print(F("After rfSwitchOn, RF_OFF is "));
+  Serial.println(tag.getField<FIELD_RF_MNGT_DYN_RF_OFF>() ? "set." : "clear.");
+
+  // -=-=-=-=-=-=-=-=-
+
+  Serial.print(F("Timing "));
+  Serial.print(cycles);
+  Serial.println(F(" disable + enable cycles for each method..."));
+
+  uint16_t failures = 0;
+
+  unsigned long start = micros();
+  for (uint16_t i = 0; i < cycles; i++)
+  {
+    if (!tag.rfSwitchOff())
+      failures++;
+    if (!tag.rfSwitchOn())
+      failures++;
+  }
+  unsigned long switchTime = micros() - start;
+
+  start = micros();
+  for (uint16_t i = 0; i < cycles; i++)
+  {
+    if (!tag.setField<FIELD_RF_MNGT_DYN_RF_DISABLE>(true))
+      failures++;
+    if (!tag.setField<FIELD_RF_MNGT_DYN_RF_DISABLE>(false))
+      failures++;
+  }
+  unsigned long registerTime = micros() - start;
+
+  // -=-=-=-=-=-=-=-=-
+
+  Serial.print(F("RF_SWITCH device select codes: "));
+  Serial.print(switchTime / (2 * cycles));
+  Serial.println(F("us per disable or enable"));
+
+  Serial.print(F("RF_MNGT_Dyn read-modify-write: "));
+  Serial.print(registerTime / (2 * cycles));
+  Serial.println(F("us per disable or enable"));
+
+  Serial.print(F("Failed transactions: "));
+  Serial.println(failures);
+}
+
+void loop()
+{
+  // Nothing to do here
+}
@@ -0,0 +1,93 @@
+/*
+  ST25DV64KC Example
+  SparkFun Electronics
+  License: MIT. Please see the license file for more information but you can
+  basically do whatever you want with this code.
+
+  This example demonstrates the RF field detector.
+  With GPO1 linked to an interrupt pin, the tag is only read when the GPO signals a field change.
+  Without it, the field is polled: quickly while a field is present, slowly while idle.
+  The detection latency and the number of bus reads are printed.
+  
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+  SparkFun Qwiic RFID Tag - ST25DV64KC : https://www.sparkfun.com/products/19035
+
+  Hardware Connections:
+  Plug a Qwiic cable into the Qwiic RFID Tag and a RedBoard
+  If you don't have a platform with a Qwiic connection use the SparkFun Qwiic Breadboard Jumper (https://www.sparkfun.com/products/14425)
+  Open the serial monitor at 115200 baud to see the output
+*/
+
+#include <SparkFun_ST25DV64KC_Arduino_Library.h> // Click here to get the library:  http://librarymanager/All#SparkFun_ST25DV64KC
+
+SFE_ST25DV64KC tag;
+
+SFE_ST25DV64KC_FieldDetector detector(tag);
+
+// Use a jumper cable to link the ST25DV64KC GPO1 pin to a digital pin
+// Comment this line out to use polling instead
+#define GPO_PIN 2 // Change this to match the digital pin you have linked GPO1 to
+
+void myISR() // Interrupt Service Routine
+{
+  detector.notify();
+}
+
+void setup()
+{
+  delay(1000);
+
+  Serial.begin(115200);
+  Wire.begin();
+
+  Serial.println(F("ST25DV64KC example."));
+
+  if (!tag.begin(Wire))
+  {
+    Serial.println(F("ST25 not detected. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  Serial.println(F("ST25 connected."));
+
+#ifdef GPO_PIN
+  // GPO1 can only be changed during an open security session.
+  // Storing the password lets the library open the session when it needs to
+  uint8_t password[8] = {0x0};
+  tag.setI2CSessionPassword(password);
+
+  pinMode(GPO_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(GPO_PIN), myISR, CHANGE);
+
+  Serial.println(F("Configuring GPO1 to signal field changes."));
+  if (!detector.beginInterrupt())
+  {
+    Serial.println(F("Could not configure GPO1. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+#else
+  Serial.println(F("Polling for the field."));
+  detector.beginPolling();
+#endif
+
+  Serial.print(F("RF field is "));
+  Serial.println(detector.fieldPresent() ? "present." : "absent.");
+}
+
+void loop()
+{
+  if (detector.update())
+  {
+    Serial.print(F("RF field "));
+    Serial.print(detector.fieldPresent() ? F("detected") : F("removed"));
+    Serial.print(F(". Latency: "));
+    Serial.print(detector.getLastLatency());
+    Serial.print(F("us. Detections: "));
+    Serial.print(detector.getDetections());
+    Serial.print(F(". Bus reads: "));
+    Serial.println(detector.getBusReads());
+  }
+}
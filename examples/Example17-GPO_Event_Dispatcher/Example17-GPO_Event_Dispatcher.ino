@@ -0,0 +1,94 @@
+/*
+  ST25DV64KC Example
+  SparkFun Electronics
+  License: MIT. Please see the license file for more information but you can
+  basically do whatever you want with this code.
+
+  This example demonstrates the GPO event dispatcher.
+  The GPO interrupt service routine only records that the GPO fired. loop() reads the interrupt status
+  register once and calls a handler for each event: field rising, field falling and RF write.
+  
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+  SparkFun Qwiic RFID Tag - ST25DV64KC : https://www.sparkfun.com/products/19035
+
+  Hardware Connections:
+  Plug a Qwiic cable into the Qwiic RFID Tag and a RedBoard
+  If you don't have a platform with a Qwiic connection use the SparkFun Qwiic Breadboard Jumper (https://www.sparkfun.com/products/14425)
+  Open the serial monitor at 115200 baud to see the output
+*/
+
+#include <SparkFun_ST25DV64KC_Arduino_Library.h> // Click here to get the library:  http://librarymanager/All#SparkFun_ST25DV64KC
+
+SFE_ST25DV64KC tag;
+
+SFE_ST25DV64KC_EventDispatcher dispatcher(tag);
+
+// Use a jumper cable to link the ST25DV64KC GPO1 pin to a digital pin
+const uint8_t GPO_PIN = 2; // Change this to match the digital pin you have linked GPO1 to
+
+void myISR() // Interrupt Service Routine
+{
+  dispatcher.notify(); // No I2C in here!
+}
+
+void fieldHandler(SF_ST25DV64KC_EVENT event)
+{
+  Serial.println(event == SF_ST25DV64KC_EVENT::FIELD_RISING ? F("RF field rising.") : F("RF field falling."));
+}
+
+void writeHandler(SF_ST25DV64KC_EVENT event)
+{
+  (void)event;
+  Serial.println(F("RF write to the user memory."));
+}
+
+void setup()
+{
+  delay(1000);
+
+  Serial.begin(115200);
+  Wire.begin();
+
+  Serial.println(F("ST25DV64KC example."));
+
+  if (!tag.begin(Wire))
+  {
+    Serial.println(F("ST25 not detected. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  Serial.println(F("ST25 connected."));
+
+  // GPO1 can only be changed during an open security session.
+  // Storing the password lets the library open the session when it needs to
+  uint8_t password[8] = {0x0};
+  tag.setI2CSessionPassword(password);
+
+  dispatcher.setEventHandler(SF_ST25DV64KC_EVENT::FIELD_RISING, fieldHandler);
+  dispatcher.setEventHandler(SF_ST25DV64KC_EVENT::FIELD_FALLING, fieldHandler);
+  dispatcher.setEventHandler(SF_ST25DV64KC_EVENT::RF_WRITE, writeHandler);
+
+  Serial.println(F("Configuring GPO1 for the events which have handlers."));
+  if (!dispatcher.enableEvents())
+  {
+    Serial.println(F("Could not configure GPO1. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  pinMode(GPO_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(GPO_PIN), myISR, CHANGE);
+}
+
+void loop()
+{
+  if (dispatcher.service() != 0)
+  {
+    Serial.print(F("Notifications: "));
+    Serial.print(dispatcher.getNotifications());
+    Serial.print(F(". Bus reads: "));
+    Serial.println(dispatcher.getBusReads());
+  }
+}
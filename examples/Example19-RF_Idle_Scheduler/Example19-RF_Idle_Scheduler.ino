@@ -0,0 +1,110 @@
+/*
+  ST25DV64KC Example
+  SparkFun Electronics
+  License: MIT. Please see the license file for more information but you can
+  basically do whatever you want with this code.
+
+  This example demonstrates the RF-aware write scheduler.
+  Every few seconds the sketch wants to refresh an NDEF Text record with the current uptime.
+  Instead of writing straight away - and being NACKed if a phone is reading the tag - the refresh
+  is held until RF is likely to be idle. The collision and retry rates are printed.
+  
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+  SparkFun Qwiic RFID Tag - ST25DV64KC : https://www.sparkfun.com/products/19035
+
+  Hardware Connections:
+  Plug a Qwiic cable into the Qwiic RFID Tag and a RedBoard
+  If you don't have a platform with a Qwiic connection use the SparkFun Qwiic Breadboard Jumper (https://www.sparkfun.com/products/14425)
+  Open the serial monitor at 115200 baud to see the output
+*/
+
+#include <SparkFun_ST25DV64KC_Arduino_Library.h> // Click here to get the library:  http://librarymanager/All#SparkFun_ST25DV64KC
+
+SFE_ST25DV64KC_NDEF tag;
+
+SFE_ST25DV64KC_EventDispatcher dispatcher(tag);
+SFE_ST25DV64KC_EventQueue queue;
+SFE_ST25DV64KC_RFScheduler scheduler(tag);
+
+// Use a jumper cable to link the ST25DV64KC GPO1 pin to a digital pin
+const uint8_t GPO_PIN = 2; // Change this to match the digital pin you have linked GPO1 to
+
+char uptimeText[32];
+
+void myISR() // Interrupt Service Routine
+{
+  queue.push();
+}
+
+void rfHandler(SF_ST25DV64KC_EVENT event)
+{
+  scheduler.onEvent(event); // Let the scheduler learn when RF is busy
+}
+
+bool refreshNDEF(SFE_ST25DV64KC &, void *context) // The deferred write
+{
+  uint16_t memLoc = tag.getCCFileLen();
+  return tag.writeNDEFText((const char *)context, &memLoc);
+}
+
+void setup()
+{
+  delay(1000);
+
+  Serial.begin(115200);
+  Wire.begin();
+
+  Serial.println(F("ST25DV64KC example."));
+
+  if (!tag.begin(Wire))
+  {
+    Serial.println(F("ST25 not detected. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  Serial.println(F("ST25 connected."));
+
+  // GPO1 can only be changed during an open security session.
+  // Storing the password lets the library open the session when it needs to
+  uint8_t password[8] = {0x0};
+  tag.setI2CSessionPassword(password);
+
+  dispatcher.setEventHandler(SF_ST25DV64KC_EVENT::FIELD_RISING, rfHandler);
+  dispatcher.setEventHandler(SF_ST25DV64KC_EVENT::FIELD_FALLING, rfHandler);
+  dispatcher.setEventHandler(SF_ST25DV64KC_EVENT::RF_ACTIVITY, rfHandler);
+  dispatcher.enableEvents();
+
+  pinMode(GPO_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(GPO_PIN), myISR, CHANGE);
+
+  tag.writeCCFile8Byte();
+}
+
+void loop()
+{
+  dispatcher.service(queue);
+
+  static unsigned long lastRefresh = 0;
+  if (millis() - lastRefresh > 3000)
+  {
+    lastRefresh = millis();
+    snprintf(uptimeText, sizeof(uptimeText), "Uptime: %lus", millis() / 1000);
+    scheduler.defer(refreshNDEF, uptimeText); // Held until RF is likely to be idle
+  }
+
+  if (scheduler.run())
+  {
+    Serial.print(F("NDEF refreshed. Sessions: "));
+    Serial.print(scheduler.getSessionCount());
+    Serial.print(F(". Average session: "));
+    Serial.print(scheduler.getAverageSessionLength());
+    Serial.print(F("ms. Collision rate: "));
+    Serial.print(scheduler.getCollisionRate(), 2);
+    Serial.print(F(". Retry rate: "));
+    Serial.print(scheduler.getRetryRate(), 2);
+    Serial.print(F(". Merged refreshes: "));
+    Serial.println(scheduler.getWritesCoalesced());
+  }
+}
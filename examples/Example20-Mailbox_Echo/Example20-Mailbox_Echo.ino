@@ -0,0 +1,99 @@
+/*
+  ST25DV64KC Example
+  SparkFun Electronics
+  License: MIT. Please see the license file for more information but you can
+  basically do whatever you want with this code.
+
+  This example demonstrates the Fast Transfer Mode mailbox.
+  Each message a phone puts in the mailbox is printed, then sent back with its bytes reversed.
+  Use an app which supports Fast Transfer Mode - e.g. ST's "NFC Tap" - to send and receive the messages.
+  
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+  SparkFun Qwiic RFID Tag - ST25DV64KC : https://www.sparkfun.com/products/19035
+
+  Hardware Connections:
+  Plug a Qwiic cable into the Qwiic RFID Tag and a RedBoard
+  If you don't have a platform with a Qwiic connection use the SparkFun Qwiic Breadboard Jumper (https://www.sparkfun.com/products/14425)
+  Open the serial monitor at 115200 baud to see the output
+*/
+
+#include <SparkFun_ST25DV64KC_Arduino_Library.h> // Click here to get the library:  http://librarymanager/All#SparkFun_ST25DV64KC
+
+SFE_ST25DV64KC tag;
+
+void setup()
+{
+  delay(1000);
+
+  Serial.begin(115200);
+  Wire.begin();
+
+  Serial.println(F("ST25DV64KC example."));
+
+  if (!tag.begin(Wire))
+  {
+    Serial.println(F("ST25 not detected. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  Serial.println(F("ST25 connected."));
+
+  // MB_MODE is in a static register, so enabling the mailbox the first time needs the security session.
+  // Storing the password lets the library open the session when it needs to
+  uint8_t password[8] = {0x0};
+  tag.setI2CSessionPassword(password);
+
+  // Release unread replies after 480ms, so a phone which goes away does not block the channel
+  tag.setMailboxWatchdogMillis(480);
+
+  if (!tag.enableMailbox())
+  {
+    Serial.println(F("Could not enable the mailbox. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  Serial.println(F("Mailbox enabled. Send a message from your phone."));
+}
+
+void loop()
+{
+  // MB_CTRL_Dyn, MB_LEN_Dyn and the message are read in one burst. A short message costs a single bus read
+  uint8_t buffer[32 + LEN_MAILBOX_HEADER];
+  uint16_t length;
+
+  if (tag.hostReadMessageBurst(buffer, sizeof(buffer), &length) && (length > 0))
+  {
+    uint8_t *message = buffer + LEN_MAILBOX_HEADER; // The message is used where it is: no copy
+
+    Serial.print(F("Received "));
+    Serial.print(length);
+    Serial.print(F(" bytes:"));
+    for (uint16_t i = 0; i < length; i++)
+    {
+      Serial.print(F(" 0x"));
+      if (message[i] < 0x10)
+        Serial.print(F("0"));
+      Serial.print(message[i], HEX);
+    }
+    Serial.println();
+
+    // Reverse the message
+    for (uint16_t i = 0; i < length / 2; i++)
+    {
+      uint8_t temp = message[i];
+      message[i] = message[length - 1 - i];
+      message[length - 1 - i] = temp;
+    }
+
+    // Replies are sent in one I2C transaction, so keep them within the Wire buffer (st25_io.wireBufferLength - 2)
+    if (length + 2 > tag.st25_io.wireBufferLength)
+      length = tag.st25_io.wireBufferLength - 2;
+
+    Serial.println(tag.hostPutMessage(message, length) ? F("Reply sent.") : F("Could not send the reply."));
+  }
+
+  delay(50);
+}
@@ -0,0 +1,152 @@
+/*
+  ST25DV64KC Example
+  SparkFun Electronics
+  License: MIT. Please see the license file for more information but you can
+  basically do whatever you want with this code.
+
+  This example demonstrates the outgoing mailbox queue.
+  Each message a phone puts in the mailbox is answered with three replies. The mailbox only holds one
+  message at a time, so the replies are queued and each is put in the mailbox as soon as the phone has
+  collected the previous one. The queue depth and the delivery latency of each reply are printed.
+  Use an app which supports Fast Transfer Mode - e.g. ST's "NFC Tap" - to send and receive the messages.
+  
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+  SparkFun Qwiic RFID Tag - ST25DV64KC : https://www.sparkfun.com/products/19035
+
+  Hardware Connections:
+  Plug a Qwiic cable into the Qwiic RFID Tag and a RedBoard
+  If you don't have a platform with a Qwiic connection use the SparkFun Qwiic Breadboard Jumper (https://www.sparkfun.com/products/14425)
+  Use a jumper cable to link the GPO1 pin to a digital pin (see GPO_PIN below)
+  Open the serial monitor at 115200 baud to see the output
+*/
+
+#include <SparkFun_ST25DV64KC_Arduino_Library.h> // Click here to get the library:  http://librarymanager/All#SparkFun_ST25DV64KC
+
+SFE_ST25DV64KC tag;
+
+SFE_ST25DV64KC_EventDispatcher dispatcher(tag);
+SFE_ST25DV64KC_EventQueue queue;
+SFE_ST25DV64KC_MailboxQueue outbox(tag);
+
+// Use a jumper cable to link the ST25DV64KC GPO1 pin to a digital pin
+const uint8_t GPO_PIN = 2; // Change this to match the digital pin you have linked GPO1 to
+
+bool messageWaiting = false;
+
+void myISR() // Interrupt Service Routine
+{
+  queue.push();
+}
+
+void putMsgHandler(SF_ST25DV64KC_EVENT event)
+{
+  (void)event;
+  messageWaiting = true; // The phone has put a message in the mailbox. Read it in loop()
+}
+
+void getMsgHandler(SF_ST25DV64KC_EVENT event)
+{
+  outbox.onEvent(event); // The phone has collected a reply. The next one can go
+}
+
+void delivered(unsigned long latency, bool wasDelivered)
+{
+  Serial.print(wasDelivered ? F("Reply collected after ") : F("Reply released by the watchdog after "));
+  Serial.print(latency);
+  Serial.print(F("ms. Queue depth: "));
+  Serial.println(outbox.getDepth());
+}
+
+void setup()
+{
+  delay(1000);
+
+  Serial.begin(115200);
+  Wire.begin();
+
+  Serial.println(F("ST25DV64KC example."));
+
+  if (!tag.begin(Wire))
+  {
+    Serial.println(F("ST25 not detected. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  Serial.println(F("ST25 connected."));
+
+  // GPO1 and MB_MODE can only be changed during an open security session.
+  // Storing the password lets the library open the session when it needs to
+  uint8_t password[8] = {0x0};
+  tag.setI2CSessionPassword(password);
+
+  // Release unread replies after 480ms, so a phone which goes away does not block the queue
+  tag.setMailboxWatchdogMillis(480);
+
+  if (!tag.enableMailbox())
+  {
+    Serial.println(F("Could not enable the mailbox. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  dispatcher.setEventHandler(SF_ST25DV64KC_EVENT::RF_PUT_MSG, putMsgHandler);
+  dispatcher.setEventHandler(SF_ST25DV64KC_EVENT::RF_GET_MSG, getMsgHandler);
+  dispatcher.enableEvents();
+
+  pinMode(GPO_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(GPO_PIN), myISR, CHANGE);
+
+  // RF_GET_MSG tells the queue when a reply has been collected. Polling is only needed to notice replies released by the watchdog
+  outbox.setPollInterval(500);
+  outbox.setDeliveryCallback(delivered);
+
+  Serial.println(F("Mailbox enabled. Send a message from your phone."));
+}
+
+void loop()
+{
+  dispatcher.service(queue);
+
+  if (messageWaiting)
+  {
+    messageWaiting = false;
+
+    uint8_t buffer[32 + LEN_MAILBOX_HEADER];
+    uint16_t length;
+
+    if (tag.hostReadMessageBurst(buffer, sizeof(buffer), &length) && (length > 0))
+    {
+      Serial.print(F("Received "));
+      Serial.print(length);
+      Serial.println(F(" bytes. Queueing three replies."));
+
+      char reply[SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE];
+      for (uint8_t i = 1; i <= 3; i++)
+      {
+        int replyLength = snprintf(reply, sizeof(reply), "Reply %d of 3 at %lums", i, millis());
+        if (!outbox.post((const uint8_t *)reply, replyLength))
+          Serial.println(F("The queue is full."));
+      }
+    }
+  }
+
+  outbox.service();
+
+  static unsigned long lastPrint = 0;
+  if (millis() - lastPrint > 10000)
+  {
+    lastPrint = millis();
+    Serial.print(F("Delivered: "));
+    Serial.print(outbox.getDelivered());
+    Serial.print(F(". Expired: "));
+    Serial.print(outbox.getExpired());
+    Serial.print(F(". Average latency: "));
+    Serial.print(outbox.getAverageLatency(), 1);
+    Serial.print(F("ms. Max latency: "));
+    Serial.print(outbox.getMaxLatency());
+    Serial.print(F("ms. Status reads: "));
+    Serial.println(outbox.getStatusReads());
+  }
+}
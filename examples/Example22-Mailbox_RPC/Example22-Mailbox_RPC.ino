@@ -0,0 +1,131 @@
+/*
+  ST25DV64KC Example
+  SparkFun Electronics
+  License: MIT. Please see the license file for more information but you can
+  basically do whatever you want with this code.
+
+  This example demonstrates the mailbox request/response dispatcher.
+  A phone sends requests through the Fast Transfer Mode mailbox: a one-byte opcode, a length byte and a body.
+  The sketch answers three of them:
+    0x01 - read the uptime (ms). The response body is four bytes, little-endian
+    0x02 - set the LED: the body is one byte, 0 or 1. The response body is empty
+    0x03 - echo: the response body is the request body, reversed
+  Use an app which supports Fast Transfer Mode - e.g. ST's "NFC Tap" - to send the requests.
+  
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+  SparkFun Qwiic RFID Tag - ST25DV64KC : https://www.sparkfun.com/products/19035
+
+  Hardware Connections:
+  Plug a Qwiic cable into the Qwiic RFID Tag and a RedBoard
+  If you don't have a platform with a Qwiic connection use the SparkFun Qwiic Breadboard Jumper (https://www.sparkfun.com/products/14425)
+  Open the serial monitor at 115200 baud to see the output
+*/
+
+#include <SparkFun_ST25DV64KC_Arduino_Library.h> // Click here to get the library:  http://librarymanager/All#SparkFun_ST25DV64KC
+
+SFE_ST25DV64KC tag;
+
+SFE_ST25DV64KC_MailboxRPC rpc(tag);
+
+const uint8_t OP_UPTIME = 0x01;
+const uint8_t OP_SET_LED = 0x02;
+const uint8_t OP_ECHO = 0x03;
+
+int16_t uptimeHandler(uint8_t *body, uint8_t length, uint8_t maxResponse, void *context)
+{
+  (void)length;
+  (void)maxResponse; // Always at least 4
+  (void)context;
+
+  unsigned long now = millis();
+  for (uint8_t i = 0; i < 4; i++) // The response is written over the request body
+    body[i] = (now >> (8 * i)) & 0xFF;
+  return 4;
+}
+
+int16_t ledHandler(uint8_t *body, uint8_t length, uint8_t maxResponse, void *context)
+{
+  (void)maxResponse;
+  (void)context;
+
+  if ((length != 1) || (body[0] > 1))
+    return SFE_ST25DV64KC_RPC_FAILED; // The phone gets a HANDLER_FAILED error response
+
+  digitalWrite(LED_BUILTIN, body[0] ? HIGH : LOW);
+  return 0; // An empty response body
+}
+
+int16_t echoHandler(uint8_t *body, uint8_t length, uint8_t maxResponse, void *context)
+{
+  (void)context;
+
+  if (length > maxResponse)
+    length = maxResponse;
+
+  // Reverse the body where it is. Nothing is copied
+  for (uint8_t i = 0; i < length / 2; i++)
+  {
+    uint8_t temp = body[i];
+    body[i] = body[length - 1 - i];
+    body[length - 1 - i] = temp;
+  }
+  return length;
+}
+
+void setup()
+{
+  delay(1000);
+
+  Serial.begin(115200);
+  Wire.begin();
+
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  Serial.println(F("ST25DV64KC example."));
+
+  if (!tag.begin(Wire))
+  {
+    Serial.println(F("ST25 not detected. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  Serial.println(F("ST25 connected."));
+
+  // MB_MODE is in a static register, so enabling the mailbox the first time needs the security session.
+  // Storing the password lets the library open the session when it needs to
+  uint8_t password[8] = {0x0};
+  tag.setI2CSessionPassword(password);
+
+  // Release unread responses after 480ms, so a phone which goes away does not block the channel
+  tag.setMailboxWatchdogMillis(480);
+
+  if (!tag.enableMailbox())
+  {
+    Serial.println(F("Could not enable the mailbox. Freezing..."));
+    while (1) // Do nothing more
+      ;
+  }
+
+  rpc.setHandler(OP_UPTIME, uptimeHandler);
+  rpc.setHandler(OP_SET_LED, ledHandler);
+  rpc.setHandler(OP_ECHO, echoHandler);
+
+  Serial.println(F("Mailbox enabled. Send a request from your phone."));
+}
+
+void loop()
+{
+  if (rpc.service())
+  {
+    Serial.print(F("Request served in "));
+    Serial.print(rpc.getLastBusTransfers());
+    Serial.print(F(" I2C transfers. Requests: "));
+    Serial.print(rpc.getRequests());
+    Serial.print(F(". Error responses: "));
+    Serial.println(rpc.getErrorResponses());
+  }
+
+  delay(20);
+}
@@ -19,10 +19,40 @@
 #include "SparkFun_ST25DV64KC_Arduino_Library.h"
 #include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
 
-bool SFE_ST25DV64KC::begin(TwoWire &i2cPort)
+bool SFE_ST25DV64KC::begin(TwoWire &i2cPort, SF_ST25DV64KC_STARTUP startup)
 {
-  st25_io.begin(i2cPort);
-  return isConnected();
+  unsigned long startTime = micros();
+  bool success;
+
+  if (startup == SF_ST25DV64KC_STARTUP::FAST)
+  {
+    success = st25_io.begin(i2cPort); // A single address probe
+  }
+  else
+  {
+    st25_io.begin(i2cPort, false); // The identity burst read doubles as the probe
+
+    success = readDeviceIdentity();
+
+    // Check the identity describes an ST25DV: 4-byte blocks, and an IC reference which matches a known memory size
+    // (readDeviceIdentity only sets the variant when both match)
+    if (success && ((_identity.blockSize != 0x03) || (_identity.variant == SF_ST25DV64KC_VARIANT::UNKNOWN)))
+    {
+      reportError(SF_ST25DV64KC_ERROR::INVALID_DEVICE);
+      _identity.valid = false;
+      success = false;
+    }
+
+    if (success && (startup == SF_ST25DV64KC_STARTUP::VERIFIED_WARM))
+    {
+      invalidateFTMCache();
+      ftmEnabled(); // Read MB_CTRL_DYN into the FTM cache
+    }
+  }
+
+  _startupMicros = micros() - startTime;
+
+  return success;
 }
 
 void SFE_ST25DV64KC::setErrorCallback(void (*errorCallback)(SF_ST25DV64KC_ERROR errorCode))
@@ -30,45 +60,126 @@ void SFE_ST25DV64KC::setErrorCallback(void (*errorCallback)(SF_ST25DV64KC_ERROR
   _errorCallback = errorCallback;
 }
 
-const char *SFE_ST25DV64KC::errorCodeString(SF_ST25DV64KC_ERROR errorCode)
+void SFE_ST25DV64KC::reportError(SF_ST25DV64KC_ERROR errorCode)
 {
-  switch (errorCode)
-  {
-  case SF_ST25DV64KC_ERROR::NONE:
-    return "NONE";
-    break;
-  case SF_ST25DV64KC_ERROR::I2C_INITIALIZATION_ERROR:
-    return "I2C_INITIALIZATION_ERROR";
-    break;
-  case SF_ST25DV64KC_ERROR::INVALID_DEVICE:
-    return "INVALID_DEVICE";
-    break;
-  case SF_ST25DV64KC_ERROR::I2C_SESSION_NOT_OPENED:
-    return "I2C_SESSION_NOT_OPENED";
-    break;
-  case SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID:
-    return "I2CSS_MEMORY_AREA_INVALID";
-    break;
-  case SF_ST25DV64KC_ERROR::INVALID_WATCHDOG_VALUE:
-    return "INVALID_WATCHDOG_VALUE";
-    break;
-  case SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED:
-    return "INVALID_MEMORY_AREA_PASSED";
-    break;
-  case SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_SIZE:
-    return "INVALID_MEMORY_AREA_SIZE";
-    break;
-  case SF_ST25DV64KC_ERROR::OUT_OF_MEMORY:
-    return "OUT_OF_MEMORY";
-    break;
-  case SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR:
-    return "I2C_TRANSMISSION_ERROR";
-    break;
-  default:
-    return "UNDEFINED";
-    break;
+  SF_ST25DV64KC_ERROR_RECORD *record = &_errorLog[_errorLogHead];
+
+  record->code = errorCode;
+  record->timestamp = millis();
+
+  if (errorCode == SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR)
+  {
+    record->deviceAddress = (uint8_t)st25_io.lastTransfer.address;
+    record->registerAddress = st25_io.lastTransfer.registerAddress;
+    record->length = st25_io.lastTransfer.length;
+    record->retries = st25_io.lastTransfer.retries;
+  }
+  else
+  {
+    record->deviceAddress = 0;
+    record->registerAddress = 0;
+    record->length = 0;
+    record->retries = 0;
   }
+
+  _errorLogHead = (_errorLogHead + 1) % SFE_ST25DV64KC_ERROR_LOG_SIZE;
+  if (_errorLogCount < SFE_ST25DV64KC_ERROR_LOG_SIZE)
+    _errorLogCount++;
+
+  if (((uint8_t)errorCode < NUM_ERROR_CODES) && (_errorCounts[(uint8_t)errorCode] < 0xFFFF))
+    _errorCounts[(uint8_t)errorCode]++;
+
+  SAFE_CALLBACK(_errorCallback, errorCode);
+}
+
+bool SFE_ST25DV64KC::getErrorRecord(uint8_t index, SF_ST25DV64KC_ERROR_RECORD *record)
+{
+  if (index >= _errorLogCount)
+    return false;
+
+  *record = _errorLog[(_errorLogHead + SFE_ST25DV64KC_ERROR_LOG_SIZE - 1 - index) % SFE_ST25DV64KC_ERROR_LOG_SIZE];
+  return true;
+}
+
+void SFE_ST25DV64KC::clearErrorLog()
+{
+  _errorLogHead = 0;
+  _errorLogCount = 0;
+
+  for (uint8_t i = 0; i < NUM_ERROR_CODES; i++)
+    _errorCounts[i] = 0;
+}
+
+// Error code text, indexed by SF_ST25DV64KC_ERROR. Kept in flash (PROGMEM) so it uses no RAM on AVR
+static const char errorText00[] PROGMEM = "NONE";
+static const char errorText01[] PROGMEM = "I2C_INITIALIZATION_ERROR";
+static const char errorText02[] PROGMEM = "INVALID_DEVICE";
+static const char errorText03[] PROGMEM = "I2C_SESSION_NOT_OPENED";
+static const char errorText04[] PROGMEM = "I2CSS_MEMORY_AREA_INVALID";
+static const char errorText05[] PROGMEM = "INVALID_WATCHDOG_VALUE";
+static const char errorText06[] PROGMEM = "INVALID_MEMORY_AREA_PASSED";
+static const char errorText07[] PROGMEM = "INVALID_MEMORY_AREA_SIZE";
+static const char errorText08[] PROGMEM = "OUT_OF_MEMORY";
+static const char errorText09[] PROGMEM = "I2C_TRANSMISSION_ERROR";
+static const char errorText10[] PROGMEM = "EEPROM_ADDRESS_OUT_OF_RANGE";
+static const char errorText11[] PROGMEM = "EXCLUSIVE_WINDOW_EXPIRED";
+static const char errorText12[] PROGMEM = "MAILBOX_DISABLED";
+static const char errorText13[] PROGMEM = "MAILBOX_BUSY";
+static const char errorText14[] PROGMEM = "MAILBOX_MESSAGE_TOO_LONG";
+static const char errorText15[] PROGMEM = "MAILBOX_CRC_ERROR";
+static const char errorText16[] PROGMEM = "MAILBOX_SEQUENCE_ERROR";
+static const char errorText17[] PROGMEM = "RF_SWITCH_DISABLED";
+static const char errorTextUndefined[] PROGMEM = "UNDEFINED";
+
+static const char *const errorTextTable[] PROGMEM = {
+    errorText00, errorText01, errorText02, errorText03,
+    errorText04, errorText05, errorText06, errorText07,
+    errorText08, errorText09, errorText10, errorText11,
+    errorText12, errorText13, errorText14, errorText15,
+    errorText16, errorText17};
+
+static_assert(sizeof(errorTextTable) / sizeof(errorTextTable[0]) == NUM_ERROR_CODES, "One error text is needed for each error code");
+
+#if defined(__AVR__)
+// The size of this union is the size of the longest error text, so the AVR RAM copy always fits
+union errorTextSizes
+{
+  char t00[sizeof(errorText00)];
+  char t01[sizeof(errorText01)];
+  char t02[sizeof(errorText02)];
+  char t03[sizeof(errorText03)];
+  char t04[sizeof(errorText04)];
+  char t05[sizeof(errorText05)];
+  char t06[sizeof(errorText06)];
+  char t07[sizeof(errorText07)];
+  char t08[sizeof(errorText08)];
+  char t09[sizeof(errorText09)];
+  char t10[sizeof(errorText10)];
+  char t11[sizeof(errorText11)];
+  char t12[sizeof(errorText12)];
+  char t13[sizeof(errorText13)];
+  char t14[sizeof(errorText14)];
+  char t15[sizeof(errorText15)];
+  char t16[sizeof(errorText16)];
+  char t17[sizeof(errorText17)];
+  char tUndefined[sizeof(errorTextUndefined)];
 };
+#endif
+
+const char *SFE_ST25DV64KC::errorCodeString(SF_ST25DV64KC_ERROR errorCode)
+{
+  const char *text = ((uint8_t)errorCode < NUM_ERROR_CODES) ? (const char *)pgm_read_ptr(&errorTextTable[(uint8_t)errorCode]) : errorTextUndefined;
+
+#if defined(__AVR__)
+  // Flash can not be read through a normal pointer on AVR: copy the text into RAM.
+  // The buffer is shared by all calls, so the text is only valid until the next call
+  static char errorString[sizeof(errorTextSizes)];
+  strncpy_P(errorString, text, sizeof(errorString) - 1); // The last byte is always NULL
+  return errorString;
+#else
+  return text;
+#endif
+}
 
 bool SFE_ST25DV64KC::isConnected()
 {
@@ -82,7 +193,7 @@ bool SFE_ST25DV64KC::readRegisterValue(const SF_ST25DV64KC_ADDRESS addressType,
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
@@ -94,14 +205,63 @@ bool SFE_ST25DV64KC::readRegisterValues(const SF_ST25DV64KC_ADDRESS addressType,
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
 }
 
+bool SFE_ST25DV64KC::readDeviceIdentity()
+{
+  uint8_t tempBuffer[LEN_IDENTITY_SPAN] = {0};
+
+  bool success = st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_MEM_SIZE_BASE, tempBuffer, LEN_IDENTITY_SPAN);
+
+  if (!success)
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
+
+  // Multi-byte registers are stored LSB first
+  _identity.memorySize = ((uint16_t)tempBuffer[1] << 8) | tempBuffer[0];
+  _identity.blockSize = tempBuffer[REG_BLOCK_SIZE - REG_MEM_SIZE_BASE];
+  _identity.icRef = tempBuffer[REG_IC_REF - REG_MEM_SIZE_BASE];
+  for (uint8_t i = 0; i < LEN_UID_SIZE; i++)
+    _identity.uid[i] = tempBuffer[REG_UID_BASE - REG_MEM_SIZE_BASE + LEN_UID_SIZE - 1 - i];
+  _identity.revision = tempBuffer[REG_IC_REV - REG_MEM_SIZE_BASE];
+
+  // Detect the variant from the IC reference and memory size
+  _identity.variant = SF_ST25DV64KC_VARIANT::UNKNOWN;
+  if ((_identity.icRef == IC_REF_ST25DV04KC) && (_identity.memorySize == MEM_SIZE_ST25DV04KC))
+    _identity.variant = SF_ST25DV64KC_VARIANT::ST25DV04KC;
+  else if ((_identity.icRef == IC_REF_ST25DV16KC_64KC) && (_identity.memorySize == MEM_SIZE_ST25DV16KC))
+    _identity.variant = SF_ST25DV64KC_VARIANT::ST25DV16KC;
+  else if ((_identity.icRef == IC_REF_ST25DV16KC_64KC) && (_identity.memorySize == MEM_SIZE_ST25DV64KC))
+    _identity.variant = SF_ST25DV64KC_VARIANT::ST25DV64KC;
+
+  // The memory size registers describe the part even if the IC reference is not recognised
+  uint32_t userMemorySize = ((uint32_t)_identity.memorySize + 1) * ((uint32_t)_identity.blockSize + 1);
+  if ((userMemorySize > 0) && (userMemorySize <= EEPROM_SIZE))
+    _userMemorySize = userMemorySize;
+
+  // Area 4 runs to the end of user memory
+  if (_memoryLayout.valid)
+    computeMemoryLayout(_memoryLayout.enda, &_memoryLayout);
+
+  _identity.valid = true;
+
+  return true;
+}
+
 bool SFE_ST25DV64KC::getDeviceUID(uint8_t *values)
 {
+  if (_identity.valid)
+  {
+    memcpy(values, _identity.uid, LEN_UID_SIZE);
+    return true;
+  }
+
   uint8_t tempBuffer[8] = {0};
 
   // Get UID into tempBuffer and return it from back to front
@@ -115,7 +275,7 @@ bool SFE_ST25DV64KC::getDeviceUID(uint8_t *values)
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
@@ -123,16 +283,57 @@ bool SFE_ST25DV64KC::getDeviceUID(uint8_t *values)
 
 bool SFE_ST25DV64KC::getDeviceRevision(uint8_t *value)
 {
+  if (_identity.valid)
+  {
+    *value = _identity.revision;
+    return true;
+  }
+
   bool success =  st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_IC_REV, value);
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
 }
 
+bool SFE_ST25DV64KC::getMemorySize(uint16_t *value)
+{
+  if (!_identity.valid && !readDeviceIdentity())
+    return false;
+
+  *value = _identity.memorySize;
+  return true;
+}
+
+bool SFE_ST25DV64KC::getBlockSize(uint8_t *value)
+{
+  if (!_identity.valid && !readDeviceIdentity())
+    return false;
+
+  *value = _identity.blockSize;
+  return true;
+}
+
+bool SFE_ST25DV64KC::getICReference(uint8_t *value)
+{
+  if (!_identity.valid && !readDeviceIdentity())
+    return false;
+
+  *value = _identity.icRef;
+  return true;
+}
+
+SF_ST25DV64KC_VARIANT SFE_ST25DV64KC::getVariant()
+{
+  if (!_identity.valid && !readDeviceIdentity())
+    return SF_ST25DV64KC_VARIANT::UNKNOWN;
+
+  return _identity.variant;
+}
+
 bool SFE_ST25DV64KC::openI2CSession(uint8_t *password)
 {
   // Passwords are written MSB first and need to be sent twice with 0x09 sent after the first
@@ -152,9 +353,12 @@ bool SFE_ST25DV64KC::openI2CSession(uint8_t *password)
 
   bool success = st25_io.writeMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2C_PASSWD_BASE, tempBuffer, 17);
 
+  // The tag ACKs a wrong password too, so the session state is unknown until it is read or a protected write succeeds
+  _i2cSession = SESSION_CACHE::UNKNOWN;
+
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
@@ -162,21 +366,111 @@ bool SFE_ST25DV64KC::openI2CSession(uint8_t *password)
 
 bool SFE_ST25DV64KC::isI2CSessionOpen()
 {
-  return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::DATA, REG_I2C_SSO_DYN, BIT_I2C_SSO_DYN_I2C_SSO);
+  uint8_t value;
+
+  if (!st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::DATA, REG_I2C_SSO_DYN, &value))
+  {
+    _i2cSession = SESSION_CACHE::UNKNOWN;
+    return false;
+  }
+
+  _i2cSession = (value & BIT_I2C_SSO_DYN_I2C_SSO) ? SESSION_CACHE::OPEN : SESSION_CACHE::CLOSED;
+
+  return (_i2cSession == SESSION_CACHE::OPEN);
 }
 
-bool SFE_ST25DV64KC::writeI2CPassword(uint8_t *password)
+void SFE_ST25DV64KC::setI2CSessionPassword(const uint8_t *password)
+{
+  for (uint8_t i = 0; i < LEN_I2C_PASSWD_SIZE; i++)
+    _i2cPassword[i] = password[i];
+
+  _i2cPasswordSet = true;
+}
+
+void SFE_ST25DV64KC::clearI2CSessionPassword()
+{
+  for (uint8_t i = 0; i < LEN_I2C_PASSWD_SIZE; i++)
+    _i2cPassword[i] = 0;
+
+  _i2cPasswordSet = false;
+}
+
+bool SFE_ST25DV64KC::ensureI2CSession()
+{
+  if (_i2cSession == SESSION_CACHE::OPEN)
+    return true;
+
+  if (_i2cSession == SESSION_CACHE::UNKNOWN && isI2CSessionOpen())
+    return true;
+
+  if (_i2cPasswordSet && openI2CSession(_i2cPassword) && isI2CSessionOpen())
+    return true;
+
+  reportError(SF_ST25DV64KC_ERROR::I2C_SESSION_NOT_OPENED);
+  return false;
+}
+
+bool SFE_ST25DV64KC::readDynamicStatus(SF_ST25DV64KC_DYNAMIC_STATUS *status)
 {
-  if (!isI2CSessionOpen())
+  uint8_t tempBuffer[LEN_DYNAMIC_STATUS_SPAN] = {0};
+
+  if (!st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_GPO_CTRL_DYN, tempBuffer, LEN_DYNAMIC_STATUS_SPAN))
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_SESSION_NOT_OPENED);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
     return false;
   }
 
+  status->gpoCtrl = tempBuffer[DYN_REG_GPO_CTRL_DYN - DYN_REG_GPO_CTRL_DYN];
+  status->ehCtrl = tempBuffer[DYN_REG_EH_CTRL_DYN - DYN_REG_GPO_CTRL_DYN];
+  status->rfMngt = tempBuffer[DYN_REG_RF_MNGT_DYN - DYN_REG_GPO_CTRL_DYN];
+  status->i2cSso = tempBuffer[REG_I2C_SSO_DYN - DYN_REG_GPO_CTRL_DYN];
+
+  _i2cSession = (status->i2cSso & BIT_I2C_SSO_DYN_I2C_SSO) ? SESSION_CACHE::OPEN : SESSION_CACHE::CLOSED;
+
+  return true;
+}
+
+bool SFE_ST25DV64KC::writeSystemRegisters(const uint16_t registerAddress, uint8_t *data, const uint16_t dataLength)
+{
+  bool reopened = false;
+
+  // Known closed: open it first rather than spending a write we know will be NACKed
+  if (_i2cSession == SESSION_CACHE::CLOSED && _i2cPasswordSet)
+  {
+    openI2CSession(_i2cPassword);
+    reopened = true;
+  }
+
+  bool success = st25_io.writeMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, registerAddress, data, dataLength);
+
+  // The session may have been closed behind our back (e.g. the tag lost power). Re-open lazily and retry once
+  if (!success && _i2cPasswordSet && !reopened)
+  {
+    openI2CSession(_i2cPassword);
+    success = st25_io.writeMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, registerAddress, data, dataLength);
+  }
+
+  _i2cSession = success ? SESSION_CACHE::OPEN : SESSION_CACHE::UNKNOWN;
+
+  return success;
+}
+
+bool SFE_ST25DV64KC::writeI2CPassword(uint8_t *password)
+{
+  if (!ensureI2CSession())
+    return false;
+
   // Disable Fast Transfer Mode (datasheet page 75)
-  bool ftmIsSet = st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, BIT_FTM_MB_MODE);
-  
-  bool success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, BIT_FTM_MB_MODE);
+  uint8_t ftm = 0;
+  bool success = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, &ftm);
+  bool ftmIsSet = success && (ftm & BIT_FTM_MB_MODE);
+
+  if (ftmIsSet)
+  {
+    uint8_t ftmCleared = ftm & ~BIT_FTM_MB_MODE;
+    success = writeSystemRegisters(REG_FTM, &ftmCleared, 1);
+    _ftmCache = FTM_CACHE::UNKNOWN;
+  }
 
   // Passwords are written MSB first and need to be sent twice with 0x07 sent after the first
   // set of 8 bytes.
@@ -193,14 +487,19 @@ bool SFE_ST25DV64KC::writeI2CPassword(uint8_t *password)
   for (uint8_t i = 0; i < 8; i++)
     tempBuffer[i + 9] = tempBuffer[i];
 
-  success &= st25_io.writeMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2C_PASSWD_BASE, tempBuffer, 17);
+  bool passwordWritten = st25_io.writeMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2C_PASSWD_BASE, tempBuffer, 17);
+  success &= passwordWritten;
+
+  // Keep the stored session password in step so the session can still be re-opened
+  if (passwordWritten && _i2cPasswordSet)
+    setI2CSessionPassword(password);
 
   if (ftmIsSet)
-    success &= st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, BIT_FTM_MB_MODE);
+    success &= writeSystemRegisters(REG_FTM, &ftm, 1);
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
@@ -210,233 +509,201 @@ bool SFE_ST25DV64KC::programEEPROMReadProtectionBit(uint8_t memoryArea, bool rea
 {
   if (memoryArea < 1 || memoryArea > 4)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID);
+    reportError(SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID);
     return false;
   }
-  
-  bool success = false;
 
-  switch (memoryArea)
-  {
-  case 1:
-  {
-    if (readSecured)
-      success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM1_READ);
-    else
-      success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM1_READ);
-  }
-  break;
+  return programI2CSSBit(SF_ST25DV64KC_AREAS[memoryArea - 1].i2cssReadBit, readSecured);
+}
 
-  case 2:
+bool SFE_ST25DV64KC::programEEPROMWriteProtectionBit(uint8_t memoryArea, bool writeSecured)
+{
+  if (memoryArea < 1 || memoryArea > 4)
   {
-    if (readSecured)
-      success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM2_READ);
-    else
-      success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM2_READ);
+    reportError(SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID);
+    return false;
   }
-  break;
 
-  case 3:
+  return programI2CSSBit(SF_ST25DV64KC_AREAS[memoryArea - 1].i2cssWriteBit, writeSecured);
+}
+
+bool SFE_ST25DV64KC::getEEPROMReadProtectionBit(uint8_t memoryArea)
+{
+  if (memoryArea < 1 || memoryArea > 4)
   {
-    if (readSecured)
-      success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM3_READ);
-    else
-      success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM3_READ);
+    reportError(SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID);
+    return false;
   }
-  break;
 
-  case 4:
+  return getI2CSSBit(SF_ST25DV64KC_AREAS[memoryArea - 1].i2cssReadBit);
+}
+
+bool SFE_ST25DV64KC::getEEPROMWriteProtectionBit(uint8_t memoryArea)
+{
+  if (memoryArea < 1 || memoryArea > 4)
   {
-    if (readSecured)
-      success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM4_READ);
-    else
-      success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM4_READ);
+    reportError(SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID);
+    return false;
   }
-  break;
 
-  default:
-    break;
-  }
+  return getI2CSSBit(SF_ST25DV64KC_AREAS[memoryArea - 1].i2cssWriteBit);
+}
+
+bool SFE_ST25DV64KC::programI2CSSBit(uint8_t bitMask, bool secured)
+{
+  bool success = updateRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, bitMask, secured ? bitMask : 0);
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
 }
 
-bool SFE_ST25DV64KC::programEEPROMWriteProtectionBit(uint8_t memoryArea, bool writeSecured)
+bool SFE_ST25DV64KC::getI2CSSBit(uint8_t bitMask)
 {
-  if (memoryArea < 1 || memoryArea > 4)
+  return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, bitMask);
+}
+
+bool SFE_ST25DV64KC::writeEEPROM(uint16_t baseAddress, uint8_t *data, uint16_t dataLength)
+{
+  if ((uint32_t)baseAddress + dataLength > _userMemorySize)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID);
+    reportError(SF_ST25DV64KC_ERROR::EEPROM_ADDRESS_OUT_OF_RANGE);
     return false;
   }
 
-  bool success = false;
+  bool written = false;
+  bool ftmRestored = true;
 
-  switch (memoryArea)
-  {
-  case 1:
+  // The FTM state is cached, but RF can set MB_EN behind our back and the write is then NACKed.
+  // If the data write is NACKed, forget the cached state, read MB_CTRL_Dyn again and retry once
+  for (uint8_t attempt = 0; (attempt < 2) && !written; attempt++)
   {
-    if (writeSecured)
-      success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM1_WRITE);
-    else
-      success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM1_WRITE);
-  }
-  break;
+    if (attempt > 0)
+    {
+      if (_bulkWriteActive)
+        break; // FTM was disabled by beginBulkWrite, so the state is not the problem
+      _ftmCache = FTM_CACHE::UNKNOWN;
+    }
 
-  case 2:
-  {
-    if (writeSecured)
-      success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM2_WRITE);
-    else
-      success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM2_WRITE);
-  }
-  break;
+    // Disable FTM temporarily if enabled - unless a bulk write session has already done it
+    bool ftmWasEnabled = (!_bulkWriteActive) && ftmEnabled();
 
-  case 3:
-  {
-    if (writeSecured)
-      success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM3_WRITE);
-    else
-      success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM3_WRITE);
-  }
-  break;
+    // Do not write the data with the mailbox still enabled
+    if (ftmWasEnabled && !disableFTM())
+      break;
 
-  case 4:
-  {
-    if (writeSecured)
-      success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM4_WRITE);
-    else
-      success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM4_WRITE);
-  }
-  break;
+    written = st25_io.writeMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, baseAddress, data, dataLength);
 
-  default:
-    break;
+    // Restore FTM if previously enabled. A failure here is reported, but does not make the data worth writing again
+    if (ftmWasEnabled && !restoreFTM())
+      ftmRestored = false;
   }
 
+  bool success = written && ftmRestored;
+
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
 }
 
-bool SFE_ST25DV64KC::getEEPROMReadProtectionBit(uint8_t memoryArea)
+bool SFE_ST25DV64KC::beginBulkWrite()
 {
-  if (memoryArea < 1 || memoryArea > 4)
-  {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID);
-    return false;
-  }
-
-  switch (memoryArea)
-  {
-  case 1:
-  {
-    return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM1_READ);
-  }
-  break;
+  if (_bulkWriteActive)
+    return true;
 
-  case 2:
-  {
-    return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM2_READ);
-  }
-  break;
+  bool ftmWasEnabled = ftmEnabled();
 
-  case 3:
+  // Only enter the session once FTM is off: writeEEPROM skips its own FTM handling inside it
+  if (ftmWasEnabled && !disableFTM())
   {
-    return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM3_READ);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
   }
-  break;
 
-  case 4:
-  {
-    return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM4_READ);
-  }
-  break;
+  _bulkWriteRestoreFTM = ftmWasEnabled;
+  _bulkWriteActive = true;
 
-  default:
-    break;
-  }
-  return false;
+  return true;
 }
 
-bool SFE_ST25DV64KC::getEEPROMWriteProtectionBit(uint8_t memoryArea)
+bool SFE_ST25DV64KC::endBulkWrite()
 {
-  if (memoryArea < 1 || memoryArea > 4)
-  {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2CSS_MEMORY_AREA_INVALID);
-    return false;
-  }
+  if (!_bulkWriteActive)
+    return true;
 
-  switch (memoryArea)
-  {
-  case 1:
-  {
-    return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM1_WRITE);
-  }
-  break;
+  bool success = true;
 
-  case 2:
-  {
-    return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM2_WRITE);
-  }
-  break;
+  if (_bulkWriteRestoreFTM)
+    success = restoreFTM();
+
+  _bulkWriteActive = false;
+  _bulkWriteRestoreFTM = false;
 
-  case 3:
+  if (!success)
   {
-    return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM3_WRITE);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
-  break;
 
-  case 4:
+  return success;
+}
+
+bool SFE_ST25DV64KC::ftmEnabled()
+{
+  if (_ftmCache == FTM_CACHE::UNKNOWN)
   {
-    return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2CSS, BIT_I2CSS_MEM4_WRITE);
-  }
-  break;
+    uint8_t value;
 
-  default:
-    break;
+    if (!st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, &value))
+      return false; // Leave the cache unknown so the next call tries again
+
+    _ftmCache = (value & BIT_MB_CTRL_DYN_MB_EN) ? FTM_CACHE::ENABLED : FTM_CACHE::DISABLED;
   }
-  return false;
+
+  return (_ftmCache == FTM_CACHE::ENABLED);
 }
 
-bool SFE_ST25DV64KC::writeEEPROM(uint16_t baseAddress, uint8_t *data, uint16_t dataLength)
+bool SFE_ST25DV64KC::disableFTM()
 {
-  // Disable FTM temporarily if enabled
-  bool ftmEnabled = st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, BIT_FTM_MB_MODE);
+  // Clearing MB_MODE also clears MB_EN
+  bool success = updateRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, BIT_FTM_MB_MODE, 0);
 
-  bool success = true;
+  _ftmCache = success ? FTM_CACHE::DISABLED : FTM_CACHE::UNKNOWN;
 
-  if (ftmEnabled)
-    success &= st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, BIT_FTM_MB_MODE);
+  return success;
+}
 
-  success &= st25_io.writeMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, baseAddress, data, dataLength);
+bool SFE_ST25DV64KC::restoreFTM()
+{
+  // Re-authorise the mailbox with MB_MODE, then re-enable it with MB_EN
+  bool success = updateRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, BIT_FTM_MB_MODE, BIT_FTM_MB_MODE);
 
-  // Restore FTM if previously enabled
-  if (ftmEnabled)
-    success &= st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, BIT_FTM_MB_MODE);
+  if (success)
+    success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_MB_EN);
 
-  if (!success)
-  {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
-  }
+  _ftmCache = success ? FTM_CACHE::ENABLED : FTM_CACHE::UNKNOWN;
 
   return success;
 }
 
 bool SFE_ST25DV64KC::readEEPROM(uint16_t baseAddress, uint8_t *data, uint16_t dataLength)
 {
+  if ((uint32_t)baseAddress + dataLength > _userMemorySize)
+  {
+    reportError(SF_ST25DV64KC_ERROR::EEPROM_ADDRESS_OUT_OF_RANGE);
+    return false;
+  }
+
   bool success =  st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, baseAddress, data, dataLength);
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return (success);
@@ -446,287 +713,327 @@ bool SFE_ST25DV64KC::setMemoryAreaEndAddress(uint8_t memoryArea, uint8_t endAddr
 {
   if (memoryArea < 1 || memoryArea > 3)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
-    return false;
-  }
-
-  bool success = false;
-
-  switch (memoryArea)
-  {
-  case 1:
-    success = st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA1, endAddressValue);
-    break;
-
-  case 2:
-    success = st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA2, endAddressValue);
-    break;
-
-  case 3:
-    success = st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA3, endAddressValue);
-    break;
-
-  default:
-    break;
-  }
-
-  if (!success)
-  {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
     return false;
   }
 
-  return success;
+  return writeENDARegister(SF_ST25DV64KC_AREAS[memoryArea - 1].endaRegister, endAddressValue);
 }
 
 uint16_t SFE_ST25DV64KC::getMemoryAreaEndAddress(uint8_t memoryArea)
 {
   if (memoryArea < 1 || memoryArea > 3)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
     return 0;
   }
 
-  uint8_t value = 0;
-  bool result = false;
+  return readENDARegister(SF_ST25DV64KC_AREAS[memoryArea - 1].endaRegister);
+}
 
-  switch (memoryArea)
+bool SFE_ST25DV64KC::setAreaRfRwProtection(uint8_t memoryArea, SF_ST25DV_RF_RW_PROTECTION rw)
+{
+  if (memoryArea < 1 || memoryArea > 4)
   {
-  case 1:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA1, &value);
-    break;
-
-  case 2:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA2, &value);
-    break;
-
-  case 3:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA3, &value);
-    break;
-
-  default:
-    break;
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
+    return false;
   }
 
-  if (!result)
+  return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, SF_ST25DV64KC_AREAS[memoryArea - 1].rfssRegister, 0x0C, ((uint8_t)rw) << 2);
+}
+
+SF_ST25DV_RF_RW_PROTECTION SFE_ST25DV64KC::getAreaRfRwProtection(uint8_t memoryArea)
+{
+  if (memoryArea < 1 || memoryArea > 4)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
-    return 0;
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
+    return SF_ST25DV_RF_RW_PROTECTION::RF_RW_READ_ALWAYS_WRITE_ALWAYS; // Return the default
   }
 
-  return ((uint16_t)value * 32 + 31);
+  return ((SF_ST25DV_RF_RW_PROTECTION)((readRFSSRegister(SF_ST25DV64KC_AREAS[memoryArea - 1].rfssRegister) >> 2) & 0x03));
 }
 
-bool SFE_ST25DV64KC::setAreaRfRwProtection(uint8_t memoryArea, SF_ST25DV_RF_RW_PROTECTION rw)
+bool SFE_ST25DV64KC::setAreaRfPwdCtrl(uint8_t memoryArea, SF_ST25DV_RF_PWD_CTRL pwdCtrl)
 {
   if (memoryArea < 1 || memoryArea > 4)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
-    return 0;
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
+    return false;
   }
 
-  uint8_t value = 0;
-  bool result = false;
+  return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, SF_ST25DV64KC_AREAS[memoryArea - 1].rfssRegister, 0x03, (uint8_t)pwdCtrl);
+}
 
-  switch (memoryArea)
+SF_ST25DV_RF_PWD_CTRL SFE_ST25DV64KC::getAreaRfPwdCtrl(uint8_t memoryArea)
+{
+  if (memoryArea < 1 || memoryArea > 4)
   {
-  case 1:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA1SS, &value);
-    break;
-
-  case 2:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA2SS, &value);
-    break;
-
-  case 3:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA3SS, &value);
-    break;
-
-  case 4:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA4SS, &value);
-    break;
-
-  default:
-    break;
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
+    return SF_ST25DV_RF_PWD_CTRL::RF_PWD_NEVER; // Return the default
   }
 
-  value &= ~0x0C; // Clear the two RW bits
-  value |= ((uint8_t)rw) << 2; // Or in the new RW bits
+  return ((SF_ST25DV_RF_PWD_CTRL)(readRFSSRegister(SF_ST25DV64KC_AREAS[memoryArea - 1].rfssRegister) & 0x03));
+}
 
-  switch (memoryArea)
+bool SFE_ST25DV64KC::setAreaRfSecurity(uint8_t memoryArea, SF_ST25DV_RF_RW_PROTECTION rw, SF_ST25DV_RF_PWD_CTRL pwdCtrl)
+{
+  if (memoryArea < 1 || memoryArea > 4)
   {
-  case 1:
-    result &= st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA1SS, value);
-    break;
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
+    return false;
+  }
+
+  return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, SF_ST25DV64KC_AREAS[memoryArea - 1].rfssRegister, 0x0F, (((uint8_t)rw) << 2) | (uint8_t)pwdCtrl);
+}
 
-  case 2:
-    result &= st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA2SS, value);
-    break;
+bool SFE_ST25DV64KC::setAllAreasRfSecurity(const SF_ST25DV_RF_RW_PROTECTION *rw, const SF_ST25DV_RF_PWD_CTRL *pwdCtrl)
+{
+  // The RFAxSS registers are interleaved with ENDA1-3. Read the whole span in one burst.
+  // The system area cannot be written sequentially, so write back only the RFAxSS bytes which change, one at a time.
+  // ENDAx are never written.
+  uint8_t span[LEN_RFAXSS_SPAN] = {0};
 
-  case 3:
-    result &= st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA3SS, value);
-    break;
+  bool result = st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA1SS, span, LEN_RFAXSS_SPAN);
 
-  case 4:
-    result &= st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA4SS, value);
-    break;
+  for (uint8_t i = 0; result && (i < 4); i++)
+  {
+    uint16_t registerAddress = SF_ST25DV64KC_AREAS[i].rfssRegister;
+    uint8_t value = span[registerAddress - REG_RFA1SS];
+    value &= ~0x0F; // Clear the RW and pwd ctrl bits
+    value |= (((uint8_t)rw[i]) << 2) | (uint8_t)pwdCtrl[i]; // Or in the new bits
 
-  default:
-    break;
+    if (value != span[registerAddress - REG_RFA1SS])
+      result = writeSystemRegisters(registerAddress, &value, 1);
   }
 
   if (!result)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return result;
 }
 
-SF_ST25DV_RF_RW_PROTECTION SFE_ST25DV64KC::getAreaRfRwProtection(uint8_t memoryArea)
+bool SFE_ST25DV64KC::writeENDARegister(uint16_t registerAddress, uint8_t endAddressValue)
 {
-  if (memoryArea < 1 || memoryArea > 4)
+  // ENDA1-3 are every other register, starting at REG_ENDA1
+  uint8_t enda[3];
+  for (uint8_t i = 0; i < 3; i++)
+    enda[i] = _memoryLayout.enda[i];
+  enda[(registerAddress - REG_ENDA1) / 2] = endAddressValue;
+
+  // The tag NACKs an end address beyond user memory, or one which breaks ENDA1 <= ENDA2 <= ENDA3.
+  // Reject those up front - using the cached layout if we have it - rather than spending the write retries
+  bool inRange = ((uint16_t)endAddressValue < (_userMemorySize / MEMORY_AREA_GRANULARITY));
+  bool inOrder = (!_memoryLayout.valid) || ((enda[0] <= enda[1]) && (enda[1] <= enda[2]));
+
+  if (!inRange || !inOrder)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
-    return SF_ST25DV_RF_RW_PROTECTION::RF_RW_READ_ALWAYS_WRITE_ALWAYS; // Return the default
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_SIZE);
+    return false;
   }
 
-  uint8_t value = 0;
-  bool result = false;
+  bool success = writeSystemRegisters(registerAddress, &endAddressValue, 1);
 
-  switch (memoryArea)
+  if (!success)
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+  }
+  else if (_memoryLayout.valid)
   {
-  case 1:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA1SS, &value);
-    break;
+    computeMemoryLayout(enda, &_memoryLayout);
+  }
 
-  case 2:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA2SS, &value);
-    break;
+  return success;
+}
 
-  case 3:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA3SS, &value);
-    break;
+void SFE_ST25DV64KC::computeMemoryLayout(const uint8_t *enda, SF_ST25DV64KC_MEMORY_LAYOUT *layout)
+{
+  uint16_t start = 0;
 
-  default:
-    break;
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    uint16_t end = ((uint16_t)enda[i] * MEMORY_AREA_GRANULARITY) + (MEMORY_AREA_GRANULARITY - 1);
+    layout->enda[i] = enda[i];
+    layout->start[i] = start;
+    layout->size[i] = (end >= start) ? (end + 1 - start) : 0;
+    if (end >= start)
+      start = end + 1;
   }
 
-  if (!result)
+  // Area 4 runs from the end of area 3 to the end of user memory
+  layout->start[3] = start;
+  layout->size[3] = (_userMemorySize > start) ? (_userMemorySize - start) : 0;
+
+  layout->valid = true;
+}
+
+bool SFE_ST25DV64KC::planMemoryAreas(uint16_t area1Size, uint16_t area2Size, uint16_t area3Size, SF_ST25DV64KC_MEMORY_LAYOUT *layout)
+{
+  // Round each size up to whole 32-byte blocks
+  uint16_t blocks1 = ((uint32_t)area1Size + MEMORY_AREA_GRANULARITY - 1) / MEMORY_AREA_GRANULARITY;
+  uint16_t blocks2 = ((uint32_t)area2Size + MEMORY_AREA_GRANULARITY - 1) / MEMORY_AREA_GRANULARITY;
+  uint16_t blocks3 = ((uint32_t)area3Size + MEMORY_AREA_GRANULARITY - 1) / MEMORY_AREA_GRANULARITY;
+
+  // Area 1 is at least one block. Areas 2-4 may be empty
+  if ((blocks1 == 0) || ((uint32_t)blocks1 + blocks2 + blocks3 > (_userMemorySize / MEMORY_AREA_GRANULARITY)))
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
-    return SF_ST25DV_RF_RW_PROTECTION::RF_RW_READ_ALWAYS_WRITE_ALWAYS; // Return the default
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_SIZE);
+    return false;
   }
 
-  return ((SF_ST25DV_RF_RW_PROTECTION)((value >> 2) & 0x03));
+  uint8_t enda[3];
+  enda[0] = blocks1 - 1;
+  enda[1] = enda[0] + blocks2;
+  enda[2] = enda[1] + blocks3;
+
+  computeMemoryLayout(enda, layout);
+
+  return true;
 }
 
-bool SFE_ST25DV64KC::setAreaRfPwdCtrl(uint8_t memoryArea, SF_ST25DV_RF_PWD_CTRL pwdCtrl)
+bool SFE_ST25DV64KC::programMemoryAreas(uint16_t area1Size, uint16_t area2Size, uint16_t area3Size)
 {
-  if (memoryArea < 1 || memoryArea > 4)
+  SF_ST25DV64KC_MEMORY_LAYOUT plan;
+
+  if (!planMemoryAreas(area1Size, area2Size, area3Size, &plan))
+    return false;
+
+  // ENDA1-3 are interleaved with RFA2SS-RFA4SS: read them with one burst and step over the RFAxSS bytes
+  uint8_t span[LEN_ENDA_SPAN] = {0};
+
+  if (!st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA1, span, LEN_ENDA_SPAN))
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
-    return 0;
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
   }
 
-  uint8_t value = 0;
-  bool result = false;
+  // The tag only accepts an ENDAx write which keeps ENDA1 <= ENDA2 <= ENDA3.
+  // Raise from the top down (ENDA3, ENDA2), set ENDA1, then lower from the bottom up (ENDA2, ENDA3):
+  // every intermediate state is legal whatever the current and target layouts are.
+  static const uint8_t writeOrder[5] = {2, 1, 0, 1, 2};
+  bool success = true;
 
-  switch (memoryArea)
+  for (uint8_t step = 0; (step < 5) && success; step++)
   {
-  case 1:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA1SS, &value);
-    break;
+    uint8_t area = writeOrder[step];
+    uint8_t *current = &span[SF_ST25DV64KC_AREAS[area].endaRegister - REG_ENDA1];
+    bool raise = (step < 2);
+    bool lower = (step > 2);
 
-  case 2:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA2SS, &value);
-    break;
+    if ((plan.enda[area] == *current) || (raise && (plan.enda[area] < *current)) || (lower && (plan.enda[area] > *current)))
+      continue;
 
-  case 3:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA3SS, &value);
-    break;
+    *current = plan.enda[area];
+    success = writeSystemRegisters(SF_ST25DV64KC_AREAS[area].endaRegister, current, 1);
+  }
 
-  case 4:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA4SS, &value);
-    break;
+  // Verify all three with a single burst and cache what the tag really holds
+  if (success)
+    success = st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA1, span, LEN_ENDA_SPAN);
 
-  default:
-    break;
+  if (!success)
+  {
+    _memoryLayout.valid = false;
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
   }
 
-  value &= ~0x03; // Clear the two pwd ctrl bits
-  value |= (uint8_t)pwdCtrl; // Or in the new pwd ctrl bits
+  uint8_t enda[3] = {span[REG_ENDA1 - REG_ENDA1], span[REG_ENDA2 - REG_ENDA1], span[REG_ENDA3 - REG_ENDA1]};
+  computeMemoryLayout(enda, &_memoryLayout);
 
-  switch (memoryArea)
+  for (uint8_t i = 0; i < 3; i++)
   {
-  case 1:
-    result &= st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA1SS, value);
-    break;
-
-  case 2:
-    result &= st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA2SS, value);
-    break;
+    if (enda[i] != plan.enda[i])
+    {
+      reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_SIZE);
+      return false;
+    }
+  }
 
-  case 3:
-    result &= st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA3SS, value);
-    break;
+  return true;
+}
 
-  case 4:
-    result &= st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA4SS, value);
-    break;
+bool SFE_ST25DV64KC::readMemoryLayout()
+{
+  uint8_t span[LEN_ENDA_SPAN] = {0};
 
-  default:
-    break;
+  if (!st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_ENDA1, span, LEN_ENDA_SPAN))
+  {
+    _memoryLayout.valid = false;
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
   }
 
-  if (!result)
+  uint8_t enda[3] = {span[REG_ENDA1 - REG_ENDA1], span[REG_ENDA2 - REG_ENDA1], span[REG_ENDA3 - REG_ENDA1]};
+  computeMemoryLayout(enda, &_memoryLayout);
+
+  return true;
+}
+
+const SF_ST25DV64KC_MEMORY_LAYOUT &SFE_ST25DV64KC::getMemoryLayout()
+{
+  if (!_memoryLayout.valid)
+    readMemoryLayout();
+
+  return _memoryLayout;
+}
+
+uint8_t SFE_ST25DV64KC::getMemoryAreaOfAddress(uint16_t address)
+{
+  if (!_memoryLayout.valid && !readMemoryLayout())
+    return 0;
+
+  for (uint8_t i = 0; i < 4; i++)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    if ((address >= _memoryLayout.start[i]) && ((uint32_t)address < (uint32_t)_memoryLayout.start[i] + _memoryLayout.size[i]))
+      return i + 1;
   }
 
-  return result;
+  return 0;
 }
 
-SF_ST25DV_RF_PWD_CTRL SFE_ST25DV64KC::getAreaRfPwdCtrl(uint8_t memoryArea)
+bool SFE_ST25DV64KC::isInMemoryArea(uint8_t memoryArea, uint16_t baseAddress, uint16_t dataLength)
 {
   if (memoryArea < 1 || memoryArea > 4)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
-    return SF_ST25DV_RF_PWD_CTRL::RF_PWD_NEVER; // Return the default
+    reportError(SF_ST25DV64KC_ERROR::INVALID_MEMORY_AREA_PASSED);
+    return false;
   }
 
-  uint8_t value = 0;
-  bool result = false;
-
-  switch (memoryArea)
-  {
-  case 1:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA1SS, &value);
-    break;
+  if (!_memoryLayout.valid && !readMemoryLayout())
+    return false;
 
-  case 2:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA2SS, &value);
-    break;
+  uint32_t start = _memoryLayout.start[memoryArea - 1];
+  uint32_t end = start + _memoryLayout.size[memoryArea - 1];
 
-  case 3:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA3SS, &value);
-    break;
+  return (baseAddress >= start) && ((uint32_t)baseAddress + dataLength <= end);
+}
 
-  case 4:
-    result = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_RFA4SS, &value);
-    break;
+uint16_t SFE_ST25DV64KC::readENDARegister(uint16_t registerAddress)
+{
+  uint8_t value = 0;
 
-  default:
-    break;
+  if (!st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, registerAddress, &value))
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return 0;
   }
 
-  if (!result)
+  return ((uint16_t)value * 32 + 31);
+}
+
+uint8_t SFE_ST25DV64KC::readRFSSRegister(uint16_t registerAddress)
+{
+  uint8_t value = 0; // Read failures return the default (RF_RW_READ_ALWAYS_WRITE_ALWAYS / RF_PWD_NEVER)
+
+  if (!st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, registerAddress, &value))
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
-    return SF_ST25DV_RF_PWD_CTRL::RF_PWD_NEVER; // Return the default
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return 0;
   }
 
-  return ((SF_ST25DV_RF_PWD_CTRL)(value & 0x03));
+  return value;
 }
 
 bool SFE_ST25DV64KC::RFFieldDetected()
@@ -734,43 +1041,73 @@ bool SFE_ST25DV64KC::RFFieldDetected()
   return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_EH_CTRL_DYN, BIT_EH_CTRL_DYN_FIELD_ON);
 }
 
-bool SFE_ST25DV64KC::setGPO1Bit(uint8_t bitMask, bool enabled)
+bool SFE_ST25DV64KC::setRFSwitchEnabled(bool enabled)
 {
-  bool success;
+  bool success = modifyFields(FIELD_I2C_CFG_RF_SWITCHOFF_EN(enabled));
+  _rfSwitchCache = success ? (enabled ? RF_SWITCH_CACHE::ENABLED : RF_SWITCH_CACHE::DISABLED) : RF_SWITCH_CACHE::UNKNOWN;
+  return success;
+}
 
-  if (enabled)
-    success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO1, bitMask);
-  else
-    success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO1, bitMask);
+bool SFE_ST25DV64KC::getRFSwitchEnabled()
+{
+  if (_rfSwitchCache == RF_SWITCH_CACHE::UNKNOWN)
+  {
+    uint8_t i2cCfg;
+    if (!st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_I2C_CFG, &i2cCfg))
+    {
+      reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+      return false;
+    }
+    _rfSwitchCache = (i2cCfg & BIT_I2C_CFG_RF_SWITCHOFF_EN) ? RF_SWITCH_CACHE::ENABLED : RF_SWITCH_CACHE::DISABLED;
+  }
+
+  return _rfSwitchCache == RF_SWITCH_CACHE::ENABLED;
+}
+
+bool SFE_ST25DV64KC::sendRFSwitch(const SF_ST25DV64KC_ADDRESS address)
+{
+  // With RF_SWITCHOFF_EN clear the tag NACKs the code every time. Don't spend the retry loop on a NACK which will never clear
+  if (!getRFSwitchEnabled())
+  {
+    if (_rfSwitchCache == RF_SWITCH_CACHE::DISABLED)
+      reportError(SF_ST25DV64KC_ERROR::RF_SWITCH_DISABLED);
+    return false;
+  }
+
+  bool success = st25_io.sendDeviceSelect(address);
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    _rfSwitchCache = RF_SWITCH_CACHE::UNKNOWN; // Check the bit again next time
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
 }
 
-bool SFE_ST25DV64KC::getGPO1Bit(uint8_t bitMask)
+bool SFE_ST25DV64KC::rfSwitchOff()
 {
-  return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO1, bitMask);
+  return sendRFSwitch(SF_ST25DV64KC_ADDRESS::RF_SWITCH_OFF);
 }
 
-bool SFE_ST25DV64KC::setGPO2Bit(uint8_t bitMask, bool enabled)
+bool SFE_ST25DV64KC::rfSwitchOn()
 {
-  bool success;
+  return sendRFSwitch(SF_ST25DV64KC_ADDRESS::RF_SWITCH_ON);
+}
 
-  if (enabled)
-    success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO2, bitMask);
-  else
-    success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO2, bitMask);
+bool SFE_ST25DV64KC::setGPO1Bit(uint8_t bitMask, bool enabled)
+{
+  return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO1, bitMask, enabled ? bitMask : 0);
+}
 
-  if (!success)
-  {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
-  }
+bool SFE_ST25DV64KC::getGPO1Bit(uint8_t bitMask)
+{
+  return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO1, bitMask);
+}
 
-  return success;
+bool SFE_ST25DV64KC::setGPO2Bit(uint8_t bitMask, bool enabled)
+{
+  return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO2, bitMask, enabled ? bitMask : 0);
 }
 
 bool SFE_ST25DV64KC::getGPO2Bit(uint8_t bitMask)
@@ -789,7 +1126,7 @@ bool SFE_ST25DV64KC::setGPO_CTRL_DynBit(bool enabled)
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
@@ -808,7 +1145,7 @@ uint8_t SFE_ST25DV64KC::getIT_STS_Dyn()
 
   if (!result)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return value;
@@ -816,44 +1153,280 @@ uint8_t SFE_ST25DV64KC::getIT_STS_Dyn()
 
 bool SFE_ST25DV64KC::setEH_MODEBit(bool value)
 {
-  bool success;
+  return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_EH_MODE, BIT_EH_MODE_EH_MODE, value ? BIT_EH_MODE_EH_MODE : 0);
+}
 
-  if (value)
-    success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_EH_MODE, BIT_EH_MODE_EH_MODE);
-  else
-    success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_EH_MODE, BIT_EH_MODE_EH_MODE);
+bool SFE_ST25DV64KC::getEH_MODEBit()
+{
+  return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_EH_MODE, BIT_EH_MODE_EH_MODE);
+}
+
+bool SFE_ST25DV64KC::setEH_CTRL_DYNBit(uint8_t bitMask, bool value)
+{
+  return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_EH_CTRL_DYN, bitMask, value ? bitMask : 0);
+}
+
+bool SFE_ST25DV64KC::getEH_CTRL_DYNBit(uint8_t bitMask)
+{
+  return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_EH_CTRL_DYN, bitMask);
+}
+
+bool SFE_ST25DV64KC::setMailboxWatchdog(uint8_t value)
+{
+  if (value > MB_WDG_MAX)
+  {
+    reportError(SF_ST25DV64KC_ERROR::INVALID_WATCHDOG_VALUE);
+    return false;
+  }
+
+  // MB_MODE is left as it is. modifyRegisterBits reports its own errors
+  return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, BIT_FTM_MB_WDG, value << 1);
+}
+
+bool SFE_ST25DV64KC::setMailboxWatchdogMillis(uint16_t watchdogMillis)
+{
+  uint8_t value = 0;
+
+  if (watchdogMillis > 0)
+  {
+    value = 1;
+    while ((value <= MB_WDG_MAX) && (mailboxWatchdogMillis(value) < watchdogMillis))
+      value++;
+  }
+
+  // value is MB_WDG_MAX + 1 if watchdogMillis is too long: setMailboxWatchdog rejects it
+  return setMailboxWatchdog(value);
+}
+
+uint8_t SFE_ST25DV64KC::getMailboxWatchdog()
+{
+  uint8_t value = 0;
+
+  if (!st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, &value))
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return 0;
+  }
+
+  return (value & BIT_FTM_MB_WDG) >> 1;
+}
+
+bool SFE_ST25DV64KC::enableMailbox()
+{
+  uint8_t ftm = 0;
+  bool success = st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_FTM, &ftm);
+
+  // Only write the static register if MB_MODE is not already set: then no I2C security session is needed
+  if (success && !(ftm & BIT_FTM_MB_MODE))
+  {
+    ftm |= BIT_FTM_MB_MODE;
+    success = writeSystemRegisters(REG_FTM, &ftm, 1);
+  }
+
+  // The other MB_CTRL_Dyn bits are read-only, so there is no need to read it first
+  if (success)
+    success = st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_MB_EN);
+
+  _ftmCache = success ? FTM_CACHE::ENABLED : FTM_CACHE::UNKNOWN;
 
   if (!success)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
   }
 
   return success;
 }
 
-bool SFE_ST25DV64KC::getEH_MODEBit()
+bool SFE_ST25DV64KC::disableMailbox()
 {
-  return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_EH_MODE, BIT_EH_MODE_EH_MODE);
+  bool success = st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, 0);
+
+  _ftmCache = success ? FTM_CACHE::DISABLED : FTM_CACHE::UNKNOWN;
+
+  if (!success)
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+  }
+
+  return success;
 }
 
-bool SFE_ST25DV64KC::setEH_CTRL_DYNBit(uint8_t bitMask, bool value)
+bool SFE_ST25DV64KC::mailboxStatus(SF_ST25DV64KC_MAILBOX_STATUS *status)
 {
-  bool success;
+  uint8_t buffer[2]; // MB_CTRL_Dyn, MB_LEN_Dyn
 
-  if (value)
-    success = st25_io.setRegisterBit(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_EH_CTRL_DYN, bitMask);
-  else
-    success = st25_io.clearRegisterBit(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_EH_CTRL_DYN, bitMask);
+  if (!st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, buffer, sizeof(buffer)))
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
 
-  if (!success)
+  status->ctrl = buffer[0];
+  // MB_LEN_Dyn holds the length minus one, and is only meaningful while there is a message
+  status->length = (buffer[0] & (BIT_MB_CTRL_DYN_HOST_PUT_MSG | BIT_MB_CTRL_DYN_RF_PUT_MSG)) ? (uint16_t)buffer[1] + 1 : 0;
+
+  // The FTM state comes for free
+  _ftmCache = (buffer[0] & BIT_MB_CTRL_DYN_MB_EN) ? FTM_CACHE::ENABLED : FTM_CACHE::DISABLED;
+
+  return true;
+}
+
+bool SFE_ST25DV64KC::hostPutMessage(const uint8_t *data, uint16_t length, bool checkStatus)
+{
+  if (length == 0)
+    return false;
+
+  // The message is written in one transaction, so it must also fit in the platform's Wire buffer with the two address bytes
+  if ((length > MAILBOX_SIZE) || (length + 2 > st25_io.wireBufferLength))
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    reportError(SF_ST25DV64KC_ERROR::MAILBOX_MESSAGE_TOO_LONG);
+    return false;
+  }
+
+  if (checkStatus)
+  {
+    uint8_t ctrl;
+
+    if (!st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, &ctrl))
+    {
+      reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+      return false;
+    }
+
+    _ftmCache = (ctrl & BIT_MB_CTRL_DYN_MB_EN) ? FTM_CACHE::ENABLED : FTM_CACHE::DISABLED;
+
+    if (!(ctrl & BIT_MB_CTRL_DYN_MB_EN))
+    {
+      reportError(SF_ST25DV64KC_ERROR::MAILBOX_DISABLED);
+      return false;
+    }
+
+    // The tag NACKs a write while the mailbox holds a message. Fail now rather than retrying
+    if (ctrl & (BIT_MB_CTRL_DYN_HOST_PUT_MSG | BIT_MB_CTRL_DYN_RF_PUT_MSG))
+    {
+      reportError(SF_ST25DV64KC_ERROR::MAILBOX_BUSY);
+      return false;
+    }
+  }
+
+  // The tag must receive the whole message in one transaction: writeMultipleBytes would split it into readWriteChunkSize pieces
+  if (!st25_io.writeSingleTransaction(SF_ST25DV64KC_ADDRESS::DATA, MAILBOX_BASE, data, length))
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
+
+  return true;
+}
+
+bool SFE_ST25DV64KC::hostReadMessage(uint8_t *data, uint16_t maxLength, uint16_t *length)
+{
+  *length = 0;
+
+  SF_ST25DV64KC_MAILBOX_STATUS status;
+  if (!mailboxStatus(&status))
+    return false;
+
+  if (!(status.ctrl & BIT_MB_CTRL_DYN_RF_PUT_MSG))
+    return true; // No message from RF
+
+  *length = status.length;
+
+  if (status.length > maxLength)
+  {
+    reportError(SF_ST25DV64KC_ERROR::MAILBOX_MESSAGE_TOO_LONG);
+    return false;
+  }
+
+  if (!st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, MAILBOX_BASE, data, status.length))
+  {
+    *length = 0;
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
+
+  return true;
+}
+
+bool SFE_ST25DV64KC::hostReadMessageBurst(uint8_t *buffer, uint16_t bufferSize, uint16_t *length)
+{
+  *length = 0;
+
+  if (bufferSize < LEN_MAILBOX_HEADER)
+    return false;
+
+  // The first transaction: the header plus as much of the message as the platform's Wire buffer holds
+  uint16_t firstRead = bufferSize;
+  if (firstRead > st25_io.getBurstSize())
+    firstRead = st25_io.getBurstSize();
+  if (firstRead > MAILBOX_SIZE + LEN_MAILBOX_HEADER)
+    firstRead = MAILBOX_SIZE + LEN_MAILBOX_HEADER;
+  if (firstRead < LEN_MAILBOX_HEADER)
+    firstRead = LEN_MAILBOX_HEADER;
+
+  if (!st25_io.readBurst(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, buffer, firstRead))
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
+
+  uint8_t ctrl = buffer[0];
+  _ftmCache = (ctrl & BIT_MB_CTRL_DYN_MB_EN) ? FTM_CACHE::ENABLED : FTM_CACHE::DISABLED;
+
+  if (!(ctrl & BIT_MB_CTRL_DYN_RF_PUT_MSG))
+    return true; // No message from RF
+
+  uint16_t messageLength = (uint16_t)buffer[1] + 1;
+  uint16_t total = messageLength + LEN_MAILBOX_HEADER;
+
+  if (total > bufferSize)
+  {
+    *length = messageLength;
+    reportError(SF_ST25DV64KC_ERROR::MAILBOX_MESSAGE_TOO_LONG);
+    return false;
+  }
+
+  // Trim to the reported length: only read what the first transaction did not
+  if ((total > firstRead) && !st25_io.readBurst(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN + firstRead, buffer + firstRead, total - firstRead))
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
+
+  *length = messageLength;
+  return true;
+}
+
+bool SFE_ST25DV64KC::updateRegisterBits(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask, const uint8_t bits)
+{
+  uint8_t value = 0;
+  bool success = true;
+
+  if (bitMask != 0xFF) // No need to read the register if every bit is being written
+    success = st25_io.readSingleByte(address, registerAddress, &value);
+
+  if (success)
+  {
+    value &= ~bitMask; // Clear the field bits
+    value |= bits & bitMask; // Or in the new bits
+
+    if (address == SF_ST25DV64KC_ADDRESS::SYSTEM)
+      success = writeSystemRegisters(registerAddress, &value, 1);
+    else
+      success = st25_io.writeSingleByte(address, registerAddress, value);
   }
 
   return success;
 }
 
-bool SFE_ST25DV64KC::getEH_CTRL_DYNBit(uint8_t bitMask)
+bool SFE_ST25DV64KC::modifyRegisterBits(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask, const uint8_t bits)
 {
-  return st25_io.isBitSet(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_EH_CTRL_DYN, bitMask);
+  bool success = updateRegisterBits(address, registerAddress, bitMask, bits);
+
+  if (!success)
+  {
+    reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+  }
+
+  return success;
 }
@@ -24,16 +24,139 @@
 #include "SparkFun_ST25DV64KC_IO.h"
 #include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
 
+// Number of records kept in the error log (each record is 12 bytes of RAM on AVR)
+#ifndef SFE_ST25DV64KC_ERROR_LOG_SIZE
+#define SFE_ST25DV64KC_ERROR_LOG_SIZE 8
+#endif
+
 class SFE_ST25DV64KC
 {
+  // The batch writes static registers through writeSystemRegisters. The event dispatcher writes GPO1 through modifyRegisterBits.
+  // The helper classes report errors through reportError
+  friend class SFE_ST25DV64KC_Batch;
+  friend class SFE_ST25DV64KC_ExclusiveWindow;
+  friend class SFE_ST25DV64KC_FieldDetector;
+  friend class SFE_ST25DV64KC_EventDispatcher;
+  friend class SFE_ST25DV64KC_MailboxTransfer;
+
+protected:
+  // Error log: a ring of the most recent errors, newest at _errorLog[_errorLogHead - 1], plus a count of each kind of error
+  SF_ST25DV64KC_ERROR_RECORD _errorLog[SFE_ST25DV64KC_ERROR_LOG_SIZE];
+  uint8_t _errorLogHead = 0;
+  uint8_t _errorLogCount = 0;
+  uint16_t _errorCounts[NUM_ERROR_CODES] = {0};
+
+  // Log errorCode, with the context of the last I2C transfer if it is an I2C_TRANSMISSION_ERROR, then call the error callback
+  void reportError(SF_ST25DV64KC_ERROR errorCode);
+
+  // Area helpers shared by the run-time (memoryArea argument) and compile-time (template) forms
+  bool programI2CSSBit(uint8_t bitMask, bool secured);
+  bool getI2CSSBit(uint8_t bitMask);
+  bool writeENDARegister(uint16_t registerAddress, uint8_t endAddressValue);
+  uint16_t readENDARegister(uint16_t registerAddress);
+  uint8_t readRFSSRegister(uint16_t registerAddress);
+
+  // Read-modify-write of the bitMask bits of a register in a single read and a single write.
+  // If bitMask covers the whole register, the read is skipped.
+  // Calls the error callback if the I2C transfer fails
+  bool modifyRegisterBits(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask, const uint8_t bits);
+
+  // Tracked I2C security session state. Protected (static register) writes use it to avoid
+  // re-presenting the password when the session is already known to be open.
+  enum class SESSION_CACHE : uint8_t
+  {
+    UNKNOWN,
+    CLOSED,
+    OPEN
+  };
+  SESSION_CACHE _i2cSession = SESSION_CACHE::UNKNOWN;
+
+  // Stored I2C password (see setI2CSessionPassword), used to re-open the session lazily
+  uint8_t _i2cPassword[LEN_I2C_PASSWD_SIZE] = {0};
+  bool _i2cPasswordSet = false;
+
+  // Write to the static (SYSTEM) registers, which need an open I2C security session.
+  // If the session is known to be closed, or the write fails, and a password is stored,
+  // the session is re-opened and the write tried again once. Does not call the error callback.
+  bool writeSystemRegisters(const uint16_t registerAddress, uint8_t *data, const uint16_t dataLength);
+
+  // Read-modify-write without the error callback. SYSTEM registers are written through writeSystemRegisters
+  bool updateRegisterBits(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask, const uint8_t bits);
+
+  // Cached Fast Transfer Mode (mailbox) state, so writeEEPROM does not need to read MB_CTRL_DYN every time
+  enum class FTM_CACHE : uint8_t
+  {
+    UNKNOWN,
+    DISABLED,
+    ENABLED
+  };
+  FTM_CACHE _ftmCache = FTM_CACHE::UNKNOWN;
+
+  // Cached I2C_CFG.RF_SWITCHOFF_EN, so rfSwitchOff / rfSwitchOn only read it once
+  enum class RF_SWITCH_CACHE : uint8_t
+  {
+    UNKNOWN,
+    DISABLED,
+    ENABLED
+  };
+  RF_SWITCH_CACHE _rfSwitchCache = RF_SWITCH_CACHE::UNKNOWN;
+
+  // Send RF_SWITCH_OFF / RF_SWITCH_ON, if RF_SWITCHOFF_EN is set. Otherwise calls the error callback with RF_SWITCH_DISABLED
+  bool sendRFSwitch(const SF_ST25DV64KC_ADDRESS address);
+
+  // Cached device identity (see readDeviceIdentity)
+  SF_ST25DV64KC_IDENTITY _identity;
+
+  // User memory size in bytes, used to bounds-check EEPROM reads and writes.
+  // Defaults to the ST25DV64KC. Preset by SFE_ST25DVxxKC_NDEF, and replaced by the tag's own size when the identity is read.
+  uint16_t _userMemorySize = EEPROM_SIZE;
+
+  // Cached memory area layout (see programMemoryAreas / readMemoryLayout)
+  SF_ST25DV64KC_MEMORY_LAYOUT _memoryLayout;
+
+  // Fill in layout from the three ENDA values, using the user memory size for area 4
+  void computeMemoryLayout(const uint8_t *enda, SF_ST25DV64KC_MEMORY_LAYOUT *layout);
+
+  // Duration of the last begin()
+  unsigned long _startupMicros = 0;
+
+  // Bulk write session state
+  bool _bulkWriteActive = false;
+  bool _bulkWriteRestoreFTM = false;
+
+  // Returns true if the mailbox is enabled. Uses the cached state if known.
+  bool ftmEnabled();
+
+  // Disable / restore Fast Transfer Mode around EEPROM writes. Updates the cached state.
+  bool disableFTM();
+  bool restoreFTM();
+
+  // OR together the values of a list of typed fields
+  static uint8_t combineFieldBits() { return 0; }
+  template <class Field, class... Fields>
+  static uint8_t combineFieldBits(Field field, Fields... fields) { return field.bits | combineFieldBits(fields...); }
+
 public:
   // Error callback function pointer.
   // Function must accept a SF_ST25DV64KC_ERROR as errorCode.
   void (*_errorCallback)(SF_ST25DV64KC_ERROR errorCode) = nullptr;
 
-  // Convert errorCode to text
+  // Convert errorCode to text. On AVR the text is copied from flash into a static buffer
+  // which is overwritten by the next call: print or copy it before calling again
   const char *errorCodeString(SF_ST25DV64KC_ERROR errorCode);
 
+  // Error log. Every error is logged - whether or not an error callback is set - without using the heap.
+  // Returns the most recent error, or NONE if the log is empty
+  SF_ST25DV64KC_ERROR lastError() { return (_errorLogCount == 0) ? SF_ST25DV64KC_ERROR::NONE : _errorLog[(_errorLogHead + SFE_ST25DV64KC_ERROR_LOG_SIZE - 1) % SFE_ST25DV64KC_ERROR_LOG_SIZE].code; }
+  // Returns the number of records in the log (at most SFE_ST25DV64KC_ERROR_LOG_SIZE)
+  uint8_t getErrorLogCount() { return _errorLogCount; }
+  // Copy a record from the log. index 0 is the most recent. Returns false if there is no such record
+  bool getErrorRecord(uint8_t index, SF_ST25DV64KC_ERROR_RECORD *record);
+  // Returns how many times errorCode has been reported since the log was cleared (saturates at 65535)
+  uint16_t getErrorCount(SF_ST25DV64KC_ERROR errorCode) { return ((uint8_t)errorCode < NUM_ERROR_CODES) ? _errorCounts[(uint8_t)errorCode] : 0; }
+  // Empty the log and zero the counts
+  void clearErrorLog();
+
   // I2C communication object instance - can be used to access the
   // ST25 registers through the IO layer functions.
   SFE_ST2525DV64KC_IO st25_io;
@@ -48,7 +171,17 @@ public:
   void setErrorCallback(void (*errorCallback)(SF_ST25DV64KC_ERROR errorCode));
 
   // Initializes ST25DV64KC.
-  bool begin(TwoWire &wirePort = Wire);
+  // startup selects how much checking is done:
+  //   FAST: a single I2C address probe
+  //   VERIFIED: a single burst read of the device identity (memory size, block size, IC reference, UID and revision),
+  //     which is cached and checked to be an ST25DV: 4-byte blocks, and an IC_REF and memory size which match a known variant.
+  //     Later identity queries then do not use the bus.
+  //   VERIFIED_WARM: as VERIFIED, plus the mailbox (FTM) state is read so the first writeEEPROM does not need to
+  // Calls the error callback with INVALID_DEVICE if VERIFIED finds a device which is not an ST25DV.
+  bool begin(TwoWire &wirePort = Wire, SF_ST25DV64KC_STARTUP startup = SF_ST25DV64KC_STARTUP::FAST);
+
+  // Returns how long the last call to begin took, in microseconds
+  unsigned long getStartupTime() { return _startupMicros; }
 
   // Checks if ST25DK64KC is connected and that chip ID matches the expected result.
   bool isConnected();
@@ -59,18 +192,59 @@ public:
   // Reads multiple values from register
   bool readRegisterValues(const SF_ST25DV64KC_ADDRESS addressType, const uint16_t registerAddress, uint8_t *data, const uint16_t dataLength);
 
-  // Gets device UID (8 bytes).
+  // Reads the device identity registers (REG_MEM_SIZE_BASE to REG_IC_REV) with a single burst and caches them.
+  // Returns true on success, false otherwise.
+  bool readDeviceIdentity();
+
+  // Returns the cached device identity. identity.valid is false if it has not been read.
+  const SF_ST25DV64KC_IDENTITY &getDeviceIdentity() { return _identity; }
+
+  // Gets device UID (8 bytes). Uses the cached identity if available.
   bool getDeviceUID(uint8_t *values);
 
-  // Gets device revision.
+  // Gets device revision. Uses the cached identity if available.
   bool getDeviceRevision(uint8_t *value);
 
+  // Gets the user memory size in blocks, minus one. Reads and caches the identity if needed.
+  bool getMemorySize(uint16_t *value);
+
+  // Gets the block size in bytes, minus one. Reads and caches the identity if needed.
+  bool getBlockSize(uint8_t *value);
+
+  // Gets the IC reference code. Reads and caches the identity if needed.
+  bool getICReference(uint8_t *value);
+
+  // Returns the detected ST25DV variant (04KC, 16KC or 64KC). Reads and caches the identity if needed.
+  // Returns SF_ST25DV64KC_VARIANT::UNKNOWN if the IC reference / memory size are not recognised or the read fails.
+  SF_ST25DV64KC_VARIANT getVariant();
+
+  // Returns the user memory size in bytes used for EEPROM bounds checks
+  uint16_t getUserMemorySize() { return _userMemorySize; }
+
   // Open I2C security session.
   bool openI2CSession(uint8_t *password);
 
-  // Checks if I2C security session is open.
+  // Checks if I2C security session is open. Updates the tracked session state.
   bool isI2CSessionOpen();
 
+  // Store the I2C password so the session can be re-opened automatically when
+  // a protected write finds it closed. The password is kept in RAM.
+  void setI2CSessionPassword(const uint8_t *password);
+  void clearI2CSessionPassword();
+
+  // Make sure the I2C security session is open before a group of protected writes.
+  // No I2C traffic if the session is already known to be open.
+  // Opens the session with the stored password if it is closed.
+  // Returns true if the session is open.
+  bool ensureI2CSession();
+
+  // Forget the tracked session state, e.g. after the tag has been power cycled
+  void invalidateI2CSession() { _i2cSession = SESSION_CACHE::UNKNOWN; }
+
+  // Read GPO_CTRL_Dyn, EH_CTRL_Dyn, RF_MNGT_Dyn and I2C_SSO_Dyn in a single burst.
+  // Updates the tracked session state.
+  bool readDynamicStatus(SF_ST25DV64KC_DYNAMIC_STATUS *status);
+
   // Writes new I2C password. A session must be opened before calling this.
   // CAUTION: you will loose most of I2C functionality if you forget the password
   // since it's used to open a session to allow writing to some registers.
@@ -101,21 +275,66 @@ public:
   bool getEEPROMWriteProtectionBit(uint8_t memoryArea);
 
   // Reads block of data from EEPROM.
+  // Reads beyond the end of user memory are rejected with EEPROM_ADDRESS_OUT_OF_RANGE.
   bool readEEPROM(uint16_t baseAddress, uint8_t *data, uint16_t dataLength);
 
   // Writes block of data to EEPROM.
+  // Writes beyond the end of user memory are rejected with EEPROM_ADDRESS_OUT_OF_RANGE.
+  // Fast Transfer Mode is disabled during the write and restored afterwards if it was enabled.
+  // The FTM state is cached. If the data write is NACKed, the cached state is discarded, MB_CTRL_Dyn is read again and the write is retried once,
+  // in case RF has enabled the mailbox. Call invalidateFTMCache if something else may have changed it, to avoid the failed attempt.
+  // If FTM can not be disabled the data is not written; if it can not be restored the data is not written again, but false is returned.
   bool writeEEPROM(uint16_t baseAddress, uint8_t *data, uint16_t dataLength);
 
+  // Start a bulk write session: Fast Transfer Mode is disabled once here (if enabled) instead of
+  // around every writeEEPROM. Call endBulkWrite when finished to restore it.
+  // Returns true on success. If FTM can not be disabled, returns false without opening the session.
+  bool beginBulkWrite();
+
+  // End a bulk write session, restoring Fast Transfer Mode if beginBulkWrite disabled it.
+  // Returns true on success, false otherwise.
+  bool endBulkWrite();
+
+  // Returns true while a bulk write session is open
+  bool bulkWriteActive() { return _bulkWriteActive; }
+
+  // Forget the cached Fast Transfer Mode state. The next writeEEPROM or beginBulkWrite will read it again.
+  void invalidateFTMCache() { _ftmCache = FTM_CACHE::UNKNOWN; }
+
   // Sets memory area boundary. memoryNumber ranges from 1 to 3.
   // endAddressValue must comply with datasheet's area size specifications (page 14).
   // Returns true if memory was correctly programmed and passed all checks, false otherwise.
   // Calls the error callback if the function pointer is set and the returned value is false.
+  // Values beyond user memory - or out of order with the cached layout - are rejected without an I2C write.
   bool setMemoryAreaEndAddress(uint8_t memoryNumber, uint8_t endAddressValue);
 
   // Returns memory area end address in bytes. Memory area values range from 1 to 3.
   // Calls the error callback if the function pointer is set and the memory area value is invalid.
   uint16_t getMemoryAreaEndAddress(uint8_t memoryArea);
 
+  // Work out the ENDA1-3 values for areas 1-3 of the given sizes in bytes. Area 4 gets the rest of user memory.
+  // Sizes are rounded up to multiples of 32 bytes. Area 1 must not be empty. No I2C traffic.
+  // Returns false and calls the error callback with INVALID_MEMORY_AREA_SIZE if the areas do not fit.
+  bool planMemoryAreas(uint16_t area1Size, uint16_t area2Size, uint16_t area3Size, SF_ST25DV64KC_MEMORY_LAYOUT *layout);
+
+  // Plan the areas, write ENDA1-3 in an order which keeps ENDA1 <= ENDA2 <= ENDA3 at every step,
+  // then verify all three with a single burst read. The result is cached (see getMemoryLayout).
+  // Unchanged ENDA registers are not written. Needs an open I2C security session.
+  bool programMemoryAreas(uint16_t area1Size, uint16_t area2Size, uint16_t area3Size);
+
+  // Read ENDA1-3 with a single burst read and cache the layout
+  bool readMemoryLayout();
+
+  // Returns the cached layout. Reads it first if it is not cached yet - check layout.valid
+  const SF_ST25DV64KC_MEMORY_LAYOUT &getMemoryLayout();
+
+  // Returns the memory area (1-4) containing address, or 0 if the address is beyond user memory.
+  // Uses the cached layout: no I2C traffic once the layout is known.
+  uint8_t getMemoryAreaOfAddress(uint16_t address);
+
+  // Returns true if dataLength bytes starting at baseAddress all lie within memoryArea. Uses the cached layout.
+  bool isInMemoryArea(uint8_t memoryArea, uint16_t baseAddress, uint16_t dataLength);
+
   // Set/Get the memory area RF access Read/Write protection
   // Note: read is always allowed for area 1.
   //   For area 1: RF_RW_READ_SECURITY_WRITE_SECURITY is actually Read-Always-Write-Security
@@ -129,10 +348,72 @@ public:
   bool setAreaRfPwdCtrl(uint8_t memoryArea, SF_ST25DV_RF_PWD_CTRL pwdCtrl);
   SF_ST25DV_RF_PWD_CTRL getAreaRfPwdCtrl(uint8_t memoryArea);
 
+  // Sets both the RF access Read/Write protection and the password control for a memory area
+  // with a single read-modify-write of its RFAxSS register
+  // Calls the error callback if the I2C transfer fails
+  bool setAreaRfSecurity(uint8_t memoryArea, SF_ST25DV_RF_RW_PROTECTION rw, SF_ST25DV_RF_PWD_CTRL pwdCtrl);
+
+  // Sets the RF access Read/Write protection and the password control for all four memory areas.
+  // rw and pwdCtrl must point to arrays of 4 entries (area 1 first).
+  // RFA1SS to RFA4SS are read with one burst. The system area cannot be written sequentially,
+  // so only the registers which change are written back, one byte each. ENDA1-3 are not written
+  // Calls the error callback if the I2C transfer fails
+  bool setAllAreasRfSecurity(const SF_ST25DV_RF_RW_PROTECTION *rw, const SF_ST25DV_RF_PWD_CTRL *pwdCtrl);
+
+  // Compile-time forms of the memory area methods, e.g. getEEPROMReadProtectionBit<2>().
+  // The area is checked at compile time and the register address and bit mask are constants,
+  // so there is no run-time range check or table lookup.
+  template <uint8_t memoryArea>
+  bool programEEPROMReadProtectionBit(bool readSecured) { return programI2CSSBit(SF_ST25DV64KC_AREA<memoryArea>::I2CSS_READ, readSecured); }
+  template <uint8_t memoryArea>
+  bool programEEPROMWriteProtectionBit(bool writeSecured) { return programI2CSSBit(SF_ST25DV64KC_AREA<memoryArea>::I2CSS_WRITE, writeSecured); }
+  template <uint8_t memoryArea>
+  bool getEEPROMReadProtectionBit() { return getI2CSSBit(SF_ST25DV64KC_AREA<memoryArea>::I2CSS_READ); }
+  template <uint8_t memoryArea>
+  bool getEEPROMWriteProtectionBit() { return getI2CSSBit(SF_ST25DV64KC_AREA<memoryArea>::I2CSS_WRITE); }
+  template <uint8_t memoryArea>
+  bool setMemoryAreaEndAddress(uint8_t endAddressValue)
+  {
+    static_assert(memoryArea <= 3, "Memory area must be 1 to 3");
+    return writeENDARegister(SF_ST25DV64KC_AREA<memoryArea>::ENDA, endAddressValue);
+  }
+  template <uint8_t memoryArea>
+  uint16_t getMemoryAreaEndAddress()
+  {
+    static_assert(memoryArea <= 3, "Memory area must be 1 to 3");
+    return readENDARegister(SF_ST25DV64KC_AREA<memoryArea>::ENDA);
+  }
+  template <uint8_t memoryArea>
+  bool setAreaRfRwProtection(SF_ST25DV_RF_RW_PROTECTION rw) { return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, SF_ST25DV64KC_AREA<memoryArea>::RFSS, 0x0C, ((uint8_t)rw) << 2); }
+  template <uint8_t memoryArea>
+  SF_ST25DV_RF_RW_PROTECTION getAreaRfRwProtection() { return ((SF_ST25DV_RF_RW_PROTECTION)((readRFSSRegister(SF_ST25DV64KC_AREA<memoryArea>::RFSS) >> 2) & 0x03)); }
+  template <uint8_t memoryArea>
+  bool setAreaRfPwdCtrl(SF_ST25DV_RF_PWD_CTRL pwdCtrl) { return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, SF_ST25DV64KC_AREA<memoryArea>::RFSS, 0x03, (uint8_t)pwdCtrl); }
+  template <uint8_t memoryArea>
+  SF_ST25DV_RF_PWD_CTRL getAreaRfPwdCtrl() { return ((SF_ST25DV_RF_PWD_CTRL)(readRFSSRegister(SF_ST25DV64KC_AREA<memoryArea>::RFSS) & 0x03)); }
+  template <uint8_t memoryArea>
+  bool setAreaRfSecurity(SF_ST25DV_RF_RW_PROTECTION rw, SF_ST25DV_RF_PWD_CTRL pwdCtrl) { return modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, SF_ST25DV64KC_AREA<memoryArea>::RFSS, 0x0F, (((uint8_t)rw) << 2) | (uint8_t)pwdCtrl); }
+
   // Returns true if there's RF field on the sensor.
   bool RFFieldDetected();
 
-  // Sets a specific GPO1 register bit
+  // Enable / disable the RF_SWITCH_OFF / RF_SWITCH_ON device select codes by setting / clearing I2C_CFG.RF_SWITCHOFF_EN.
+  // Its factory value is 0: the tag NACKs the codes until it is set. I2C_CFG is a static register, so this needs an open
+  // I2C security session (or a password stored with setI2CSessionPassword). Calls the error callback if the I2C transfer fails
+  bool setRFSwitchEnabled(bool enabled);
+
+  // Returns true if RF_SWITCHOFF_EN is set. The register is read once, then cached
+  bool getRFSwitchEnabled();
+
+  // Disable / enable RF by sending the RF_SWITCH_OFF / RF_SWITCH_ON device select code.
+  // A single I2C transaction with no register address or data: no read-modify-write of RF_MNGT_Dyn.
+  // RF_OFF in RF_MNGT_Dyn (read only) reflects the result. RF_DISABLE is not changed.
+  // Needs RF_SWITCHOFF_EN (see setRFSwitchEnabled): if it is clear, nothing is sent and the error callback is called with RF_SWITCH_DISABLED
+  bool rfSwitchOff();
+  bool rfSwitchOn();
+
+  // Sets a specific GPO1 register bit. bitMask may contain several bits.
+  // See also setField / modifyFields which check at compile time that the mask belongs to GPO1
   bool setGPO1Bit(uint8_t bitMask, bool enabled);
 
   // Gets a specific GPO1 register bit
@@ -165,8 +446,93 @@ public:
 
   // Gets a specific EH_CTRL_DYN dynamic register bit
   bool getEH_CTRL_DYNBit(uint8_t bitMask);
+
+  // Sets the mailbox watchdog (MB_WDG in the FTM register): an unread message is released after 2^(value - 1) x 30ms.
+  // value ranges from 1 (30ms) to 7 (1920ms). Zero disables the watchdog.
+  // Values above 7 are rejected with INVALID_WATCHDOG_VALUE. FTM is a static register: an I2C security session is needed.
+  bool setMailboxWatchdog(uint8_t value);
+
+  // Sets the mailbox watchdog to the shortest duration which is at least watchdogMillis. Zero disables the watchdog.
+  // Durations above 1920ms are rejected with INVALID_WATCHDOG_VALUE.
+  bool setMailboxWatchdogMillis(uint16_t watchdogMillis);
+
+  // Gets the mailbox watchdog value (0 to 7). Returns 0 if the read fails
+  uint8_t getMailboxWatchdog();
+
+  // Gets the mailbox watchdog duration in ms. Returns 0 if the watchdog is disabled or the read fails
+  uint16_t getMailboxWatchdogMillis() { return mailboxWatchdogMillis(getMailboxWatchdog()); }
+
+  // Converts a mailbox watchdog value to its duration in ms
+  static uint16_t mailboxWatchdogMillis(uint8_t value) { return ((value == 0) || (value > MB_WDG_MAX)) ? 0 : MB_WDG_BASE_MS << (value - 1); }
+
+  // Fast Transfer Mode (mailbox): a 256-byte buffer shared by RF and I2C, with no EEPROM programming time or wear.
+  // Enable the mailbox: MB_MODE in the FTM register is set if needed (static: an I2C security session is needed),
+  // then MB_EN in MB_CTRL_Dyn. Updates the cached FTM state.
+  bool enableMailbox();
+
+  // Disable the mailbox by clearing MB_EN. Any message in the mailbox is discarded. MB_MODE is left set.
+  bool disableMailbox();
+
+  // Read MB_CTRL_Dyn and MB_LEN_Dyn in one burst. status->length is zero if there is no message in the mailbox.
+  // Check status->ctrl for BIT_MB_CTRL_DYN_RF_MISS_MSG (RF did not read the host's message) / HOST_MISS_MSG (I2C did not read RF's message):
+  // a message which was released by the watchdog before it was read
+  bool mailboxStatus(SF_ST25DV64KC_MAILBOX_STATUS *status);
+
+  // Put a message in the mailbox for RF to read. The message is written in a single I2C transaction, so length must be
+  // no more than MAILBOX_SIZE, and must fit in the platform's Wire buffer (st25_io.wireBufferLength - 2: 30 bytes on AVR).
+  // Longer messages are rejected with MAILBOX_MESSAGE_TOO_LONG.
+  // If checkStatus is true, MB_CTRL_Dyn is read first: a disabled mailbox is reported with MAILBOX_DISABLED,
+  // a mailbox which still holds a message (HOST_PUT_MSG or RF_PUT_MSG) with MAILBOX_BUSY.
+  bool hostPutMessage(const uint8_t *data, uint16_t length, bool checkStatus = true);
+
+  // Read the message RF has put in the mailbox. Returns true with *length zero if there is no message.
+  // If the message is longer than maxLength, *length is set to the message length, MAILBOX_MESSAGE_TOO_LONG is reported
+  // and the message is left in the mailbox. Reading the whole message clears RF_PUT_MSG.
+  bool hostReadMessage(uint8_t *data, uint16_t maxLength, uint16_t *length);
+
+  // Read the message RF has put in the mailbox with as few transactions as possible: MB_CTRL_Dyn, MB_LEN_Dyn and the message
+  // are read as one sequential burst straight into buffer. buffer[0] is MB_CTRL_Dyn, buffer[1] is MB_LEN_Dyn and the message
+  // starts at buffer + LEN_MAILBOX_HEADER: there is no copy. A buffer of MAILBOX_SIZE + LEN_MAILBOX_HEADER bytes holds any message.
+  // The first transaction reads up to st25_io.getBurstSize() bytes (the Wire buffer size, at most 255); only the rest of a longer message is read after it.
+  // *length is the message length, zero if there is no message. Too long for buffer: as hostReadMessage.
+  bool hostReadMessageBurst(uint8_t *buffer, uint16_t bufferSize, uint16_t *length);
+
+  // Typed register field access, e.g. setField<FIELD_GPO1_RF_USER_EN>(true)
+  // A field can only be used with its own register, so a mask from another register will not compile.
+  template <class Field>
+  bool getField() { return st25_io.isBitSet(Field::ADDRESS, Field::REGISTER, Field::MASK); }
+
+  template <class Field>
+  bool setField(bool enabled)
+  {
+    static_assert(Field::WRITABLE, "Field is read only");
+    return modifyFields(Field(enabled));
+  }
+
+  // Sets and clears several fields of one register with a single read-modify-write:
+  //   modifyFields(FIELD_GPO1_GPO_EN(true), FIELD_GPO1_RF_USER_EN(true), FIELD_GPO1_RF_WRITE_EN(false));
+  // The combined mask is computed at compile time. If the fields cover all eight bits, the read is skipped.
+  template <class... Fields>
+  bool modifyFields(Fields... fields)
+  {
+    static_assert(sizeof...(Fields) > 0, "At least one field is required");
+    static_assert(SF_ST25DV64KC_FIELDS<Fields...>::SAME_REGISTER, "All fields must belong to the same register");
+    static_assert(SF_ST25DV64KC_FIELDS<Fields...>::WRITABLE, "Read-only fields can not be written");
+    return modifyRegisterBits(SF_ST25DV64KC_FIELDS<Fields...>::ADDRESS, SF_ST25DV64KC_FIELDS<Fields...>::REGISTER,
+                              SF_ST25DV64KC_FIELDS<Fields...>::MASK, combineFieldBits(fields...));
+  }
 };
 
 #include "SparkFun_ST25DV64KC_NDEF.h"
+#include "SparkFun_ST25DV64KC_Batch.h"
+#include "SparkFun_ST25DV64KC_ExclusiveWindow.h"
+#include "SparkFun_ST25DV64KC_FieldDetector.h"
+#include "SparkFun_ST25DV64KC_EventQueue.h"
+#include "SparkFun_ST25DV64KC_EventDispatcher.h"
+#include "SparkFun_ST25DV64KC_RFScheduler.h"
+#include "SparkFun_ST25DV64KC_OperationScheduler.h"
+#include "SparkFun_ST25DV64KC_MailboxQueue.h"
+#include "SparkFun_ST25DV64KC_MailboxTransfer.h"
+#include "SparkFun_ST25DV64KC_MailboxRPC.h"
 
 #endif
\ No newline at end of file
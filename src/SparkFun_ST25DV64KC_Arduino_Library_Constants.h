@@ -60,6 +60,10 @@ static const uint16_t REG_I2C_PASSWD_BASE = 0x0900;
 static const uint8_t LEN_MEM_SIZE = 0x02;
 static const uint8_t LEN_UID_SIZE = 0x08;
 static const uint8_t LEN_I2C_PASSWD_SIZE = 0x08;
+static const uint8_t LEN_IDENTITY_SPAN = 0x0D; // REG_MEM_SIZE_BASE to REG_IC_REV inclusive
+static const uint8_t LEN_RFAXSS_SPAN = 0x07; // REG_RFA1SS to REG_RFA4SS inclusive (interleaved with REG_ENDAx)
+static const uint8_t LEN_ENDA_SPAN = 0x05; // REG_ENDA1 to REG_ENDA3 inclusive (interleaved with REG_RFAxSS)
+static const uint8_t LEN_DYNAMIC_STATUS_SPAN = 0x05; // DYN_REG_GPO_CTRL_DYN to REG_I2C_SSO_DYN inclusive (stops before REG_IT_STS_DYN, which clears on read)
 
 // Dynamic registers
 static const uint16_t DYN_REG_GPO_CTRL_DYN = 0x2000;
@@ -76,11 +80,31 @@ static const uint16_t MAILBOX_BASE = 0x2008;
 // Mailbox length
 static const uint8_t LEN_MAILBOX = 0xff;
 
+// Mailbox size in bytes. REG_MB_LEN_DYN holds the message length minus one
+static const uint16_t MAILBOX_SIZE = 0x100;
+
+// REG_MB_CTRL_DYN and REG_MB_LEN_DYN sit directly before MAILBOX_BASE, so status and message can be read in one burst
+static const uint8_t LEN_MAILBOX_HEADER = 0x02;
+
 // EEPROM size
 static const uint16_t EEPROM_SIZE = 0x2000;
 
+// IC references (REG_IC_REF)
+static const uint8_t IC_REF_ST25DV04KC = 0x50;
+static const uint8_t IC_REF_ST25DV16KC_64KC = 0x51;
+
+// Memory sizes (REG_MEM_SIZE_BASE: number of 4-byte blocks, minus one)
+static const uint16_t MEM_SIZE_ST25DV04KC = 0x007F;
+static const uint16_t MEM_SIZE_ST25DV16KC = 0x01FF;
+static const uint16_t MEM_SIZE_ST25DV64KC = 0x07FF;
+
 // Registers' bits definitions
 #define BIT_FTM_MB_MODE (1 << 0)
+#define BIT_FTM_MB_WDG (0x07 << 1) // Three-bit field: the mailbox watchdog
+
+// Mailbox watchdog (REG_FTM MB_WDG): duration = 2^(MB_WDG - 1) x 30ms. Zero disables the watchdog
+static const uint8_t MB_WDG_MAX = 0x07;
+static const uint16_t MB_WDG_BASE_MS = 30;
 
 #define BIT_MB_CTRL_DYN_MB_EN (1 << 0)
 #define BIT_MB_CTRL_DYN_HOST_PUT_MSG (1 << 1)
@@ -109,6 +133,8 @@ static const uint16_t EEPROM_SIZE = 0x2000;
 #define BIT_GPO2_I2C_WRITE_EN (1 << 0)
 #define BIT_GPO2_I2C_RF_OFF_EN (1 << 1)
 
+#define BIT_I2C_CFG_RF_SWITCHOFF_EN (1 << 5) // The tag only answers the RF_SWITCH_OFF / RF_SWITCH_ON device select codes when this is set
+
 #define BIT_GPO_CTRL_DYN_GPO_EN (1 << 0)
 
 #define BIT_IT_STS_DYN_RF_USER (1 << 0)
@@ -155,6 +181,204 @@ enum class SF_ST25DV64KC_ADDRESS : uint8_t
   RF_SWITCH_ON = 0x55,  // E2 = 1, E1 = 0
 };
 
+enum class SF_ST25DV64KC_VARIANT : uint8_t
+{
+  UNKNOWN,
+  ST25DV04KC, // 4 Kbit: 512 bytes of user memory
+  ST25DV16KC, // 16 Kbit: 2048 bytes of user memory
+  ST25DV64KC  // 64 Kbit: 8192 bytes of user memory
+};
+
+// Compile-time properties of each variant: user memory size and the matching Type 5 Capability Container.
+// Parts of up to 2040 bytes use a 4-byte CC File; larger parts use an 8-byte CC File (see writeCCFile8Byte)
+template <SF_ST25DV64KC_VARIANT variant>
+struct SF_ST25DV64KC_VARIANT_TRAITS;
+
+template <>
+struct SF_ST25DV64KC_VARIANT_TRAITS<SF_ST25DV64KC_VARIANT::ST25DV04KC>
+{
+  static constexpr uint16_t MEM_SIZE = MEM_SIZE_ST25DV04KC;
+  static constexpr uint16_t USER_MEMORY_SIZE = 512;
+  static constexpr uint8_t CC_FILE_LEN = 4;
+  static constexpr uint32_t CC_FILE_1 = 0xE1403F00; // MLEN = (512 - 4) / 8 = 0x3F
+  static constexpr uint32_t CC_FILE_2 = 0;
+};
+
+template <>
+struct SF_ST25DV64KC_VARIANT_TRAITS<SF_ST25DV64KC_VARIANT::ST25DV16KC>
+{
+  static constexpr uint16_t MEM_SIZE = MEM_SIZE_ST25DV16KC;
+  static constexpr uint16_t USER_MEMORY_SIZE = 2048;
+  static constexpr uint8_t CC_FILE_LEN = 8;
+  static constexpr uint32_t CC_FILE_1 = 0xE2400001;
+  static constexpr uint32_t CC_FILE_2 = 0x000000FF; // MLEN = (2048 - 8) / 8 = 0xFF
+};
+
+template <>
+struct SF_ST25DV64KC_VARIANT_TRAITS<SF_ST25DV64KC_VARIANT::ST25DV64KC>
+{
+  static constexpr uint16_t MEM_SIZE = MEM_SIZE_ST25DV64KC;
+  static constexpr uint16_t USER_MEMORY_SIZE = 8192;
+  static constexpr uint8_t CC_FILE_LEN = 8;
+  static constexpr uint32_t CC_FILE_1 = 0xE2400001;
+  static constexpr uint32_t CC_FILE_2 = 0x000003FF; // MLEN = (8192 - 8) / 8 = 0x3FF
+};
+
+// Device identity: the contiguous read-only registers REG_MEM_SIZE_BASE to REG_IC_REV
+struct SF_ST25DV64KC_IDENTITY
+{
+  bool valid = false;       // true once the identity has been read successfully
+  uint16_t memorySize = 0;  // MEM_SIZE: user memory size in blocks, minus one (e.g. 0x07FF for 2048 blocks)
+  uint8_t blockSize = 0;    // BLK_SIZE: block size in bytes, minus one (e.g. 0x03 for 4 bytes)
+  uint8_t icRef = 0;        // IC_REF: IC reference code
+  uint8_t uid[8] = {0};     // UID, most significant byte first (as returned by getDeviceUID)
+  uint8_t revision = 0;     // IC_REV: IC revision
+  SF_ST25DV64KC_VARIANT variant = SF_ST25DV64KC_VARIANT::UNKNOWN; // Detected from icRef and memorySize
+};
+
+// Memory areas are sized in blocks of 32 bytes. Area end address = (ENDAx * MEMORY_AREA_GRANULARITY) + (MEMORY_AREA_GRANULARITY - 1)
+static const uint8_t MEMORY_AREA_GRANULARITY = 32;
+
+// Memory area layout: the ENDA1-3 values and the resulting start address and size of each area in bytes
+struct SF_ST25DV64KC_MEMORY_LAYOUT
+{
+  bool valid = false;      // true once the layout has been read, planned or programmed
+  uint8_t enda[3] = {0};   // ENDA1-3 register values
+  uint16_t start[4] = {0}; // First byte of each area
+  uint16_t size[4] = {0};  // Size of each area in bytes. Areas 2-4 are empty if their size is zero
+};
+
+// An I2C transfer: which device address and register, how many bytes and how many times it was retried
+struct SF_ST25DV64KC_TRANSFER
+{
+  SF_ST25DV64KC_ADDRESS address = SF_ST25DV64KC_ADDRESS::DATA;
+  uint16_t registerAddress = 0;
+  uint16_t length = 0;
+  uint8_t retries = 0;
+};
+
+// Dynamic status snapshot: the dynamic registers DYN_REG_GPO_CTRL_DYN to REG_I2C_SSO_DYN, read in one burst
+struct SF_ST25DV64KC_DYNAMIC_STATUS
+{
+  uint8_t gpoCtrl = 0; // GPO_CTRL_Dyn
+  uint8_t ehCtrl = 0;  // EH_CTRL_Dyn: EH_EN, EH_ON, FIELD_ON, VCC_ON
+  uint8_t rfMngt = 0;  // RF_MNGT_Dyn: RF_DISABLE, RF_SLEEP
+  uint8_t i2cSso = 0;  // I2C_SSO_Dyn: I2C security session open
+};
+
+// Mailbox status: REG_MB_CTRL_DYN and REG_MB_LEN_DYN, read in one burst
+struct SF_ST25DV64KC_MAILBOX_STATUS
+{
+  uint8_t ctrl = 0;    // REG_MB_CTRL_DYN: see BIT_MB_CTRL_DYN_*
+  uint16_t length = 0; // Length of the message in the mailbox in bytes. Zero if there is no message
+};
+
+// Typed register fields. A field binds a bit mask to the register it belongs to, so a mask can only
+// be used with its own register: tag.setField<FIELD_GPO1_RF_USER_EN>(true)
+// Dynamic registers (0x2000 and above) are accessed through the DATA address, static registers through SYSTEM.
+// Read-only fields have writable false: setField and modifyFields reject them at compile time.
+template <uint16_t registerAddress, uint8_t bitMask, bool writable = true>
+struct SF_ST25DV64KC_FIELD
+{
+  static constexpr SF_ST25DV64KC_ADDRESS ADDRESS = (registerAddress >= 0x2000) ? SF_ST25DV64KC_ADDRESS::DATA : SF_ST25DV64KC_ADDRESS::SYSTEM;
+  static constexpr uint16_t REGISTER = registerAddress;
+  static constexpr uint8_t MASK = bitMask;
+  static constexpr bool WRITABLE = writable;
+
+  // The field value - used by modifyFields
+  uint8_t bits;
+  explicit constexpr SF_ST25DV64KC_FIELD(bool enabled) : bits(enabled ? bitMask : 0) {}
+};
+
+// Combined mask of a list of fields, and checks that they all belong to the same register and are all writable
+template <class... Fields>
+struct SF_ST25DV64KC_FIELDS
+{
+  static constexpr uint8_t MASK = 0;
+  static constexpr bool SAME_REGISTER = true;
+  static constexpr bool WRITABLE = true;
+  static constexpr uint16_t REGISTER = 0;
+};
+
+template <class Field, class... Fields>
+struct SF_ST25DV64KC_FIELDS<Field, Fields...>
+{
+  static constexpr uint8_t MASK = Field::MASK | SF_ST25DV64KC_FIELDS<Fields...>::MASK;
+  static constexpr bool SAME_REGISTER = (sizeof...(Fields) == 0) ||
+                                        ((Field::REGISTER == SF_ST25DV64KC_FIELDS<Fields...>::REGISTER) && SF_ST25DV64KC_FIELDS<Fields...>::SAME_REGISTER);
+  static constexpr bool WRITABLE = Field::WRITABLE && SF_ST25DV64KC_FIELDS<Fields...>::WRITABLE;
+  static constexpr uint16_t REGISTER = Field::REGISTER;
+  static constexpr SF_ST25DV64KC_ADDRESS ADDRESS = Field::ADDRESS;
+};
+
+typedef SF_ST25DV64KC_FIELD<REG_GPO1, BIT_GPO1_GPO_EN> FIELD_GPO1_GPO_EN;
+typedef SF_ST25DV64KC_FIELD<REG_GPO1, BIT_GPO1_RF_USER_EN> FIELD_GPO1_RF_USER_EN;
+typedef SF_ST25DV64KC_FIELD<REG_GPO1, BIT_GPO1_RF_ACTIVITY_EN> FIELD_GPO1_RF_ACTIVITY_EN;
+typedef SF_ST25DV64KC_FIELD<REG_GPO1, BIT_GPO1_RF_INTERRUPT_EN> FIELD_GPO1_RF_INTERRUPT_EN;
+typedef SF_ST25DV64KC_FIELD<REG_GPO1, BIT_GPO1_FIELD_CHANGE_EN> FIELD_GPO1_FIELD_CHANGE_EN;
+typedef SF_ST25DV64KC_FIELD<REG_GPO1, BIT_GPO1_RF_PUT_MSG_EN> FIELD_GPO1_RF_PUT_MSG_EN;
+typedef SF_ST25DV64KC_FIELD<REG_GPO1, BIT_GPO1_RF_GET_MSG_EN> FIELD_GPO1_RF_GET_MSG_EN;
+typedef SF_ST25DV64KC_FIELD<REG_GPO1, BIT_GPO1_RF_WRITE_EN> FIELD_GPO1_RF_WRITE_EN;
+
+typedef SF_ST25DV64KC_FIELD<REG_GPO2, BIT_GPO2_I2C_WRITE_EN> FIELD_GPO2_I2C_WRITE_EN;
+typedef SF_ST25DV64KC_FIELD<REG_GPO2, BIT_GPO2_I2C_RF_OFF_EN> FIELD_GPO2_I2C_RF_OFF_EN;
+
+typedef SF_ST25DV64KC_FIELD<REG_I2C_CFG, BIT_I2C_CFG_RF_SWITCHOFF_EN> FIELD_I2C_CFG_RF_SWITCHOFF_EN;
+
+typedef SF_ST25DV64KC_FIELD<REG_EH_MODE, BIT_EH_MODE_EH_MODE> FIELD_EH_MODE_EH_MODE;
+
+typedef SF_ST25DV64KC_FIELD<REG_RF_MNGMT, BIT_RF_MNGT_RF_DISABLE> FIELD_RF_MNGT_RF_DISABLE;
+typedef SF_ST25DV64KC_FIELD<REG_RF_MNGMT, BIT_RF_MNGT_RF_SLEEP> FIELD_RF_MNGT_RF_SLEEP;
+
+typedef SF_ST25DV64KC_FIELD<REG_FTM, BIT_FTM_MB_MODE> FIELD_FTM_MB_MODE;
+
+typedef SF_ST25DV64KC_FIELD<DYN_REG_GPO_CTRL_DYN, BIT_GPO_CTRL_DYN_GPO_EN> FIELD_GPO_CTRL_DYN_GPO_EN;
+
+typedef SF_ST25DV64KC_FIELD<DYN_REG_EH_CTRL_DYN, BIT_EH_CTRL_DYN_EH_EN> FIELD_EH_CTRL_DYN_EH_EN;
+typedef SF_ST25DV64KC_FIELD<DYN_REG_EH_CTRL_DYN, BIT_EH_CTRL_DYN_EH_ON, false> FIELD_EH_CTRL_DYN_EH_ON;
+typedef SF_ST25DV64KC_FIELD<DYN_REG_EH_CTRL_DYN, BIT_EH_CTRL_DYN_FIELD_ON, false> FIELD_EH_CTRL_DYN_FIELD_ON;
+typedef SF_ST25DV64KC_FIELD<DYN_REG_EH_CTRL_DYN, BIT_EH_CTRL_DYN_VCC_ON, false> FIELD_EH_CTRL_DYN_VCC_ON;
+
+typedef SF_ST25DV64KC_FIELD<DYN_REG_RF_MNGT_DYN, BIT_RF_MNGT_DYN_RF_DISABLE> FIELD_RF_MNGT_DYN_RF_DISABLE;
+typedef SF_ST25DV64KC_FIELD<DYN_REG_RF_MNGT_DYN, BIT_RF_MNGT_DYN_RF_SLEEP> FIELD_RF_MNGT_DYN_RF_SLEEP;
+typedef SF_ST25DV64KC_FIELD<DYN_REG_RF_MNGT_DYN, BIT_RF_MNGT_DYN_RF_OFF, false> FIELD_RF_MNGT_DYN_RF_OFF;
+
+typedef SF_ST25DV64KC_FIELD<REG_I2C_SSO_DYN, BIT_I2C_SSO_DYN_I2C_SSO, false> FIELD_I2C_SSO_DYN_I2C_SSO;
+
+typedef SF_ST25DV64KC_FIELD<REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_MB_EN> FIELD_MB_CTRL_DYN_MB_EN;
+typedef SF_ST25DV64KC_FIELD<REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_HOST_PUT_MSG, false> FIELD_MB_CTRL_DYN_HOST_PUT_MSG;
+typedef SF_ST25DV64KC_FIELD<REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_RF_PUT_MSG, false> FIELD_MB_CTRL_DYN_RF_PUT_MSG;
+typedef SF_ST25DV64KC_FIELD<REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_HOST_MISS_MSG, false> FIELD_MB_CTRL_DYN_HOST_MISS_MSG;
+typedef SF_ST25DV64KC_FIELD<REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_RF_MISS_MSG, false> FIELD_MB_CTRL_DYN_RF_MISS_MSG;
+typedef SF_ST25DV64KC_FIELD<REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_HOST_CURRENT_MSG, false> FIELD_MB_CTRL_DYN_HOST_CURRENT_MSG;
+typedef SF_ST25DV64KC_FIELD<REG_MB_CTRL_DYN, BIT_MB_CTRL_DYN_RF_CURRENT_MSG, false> FIELD_MB_CTRL_DYN_RF_CURRENT_MSG;
+
+// Memory area descriptors: the registers and bits which control each of the four user memory areas
+struct SF_ST25DV64KC_AREA_DESCRIPTOR
+{
+  uint16_t rfssRegister; // RFAxSS - RF access security
+  uint8_t i2cssReadBit;  // I2CSS read protection bit
+  uint8_t i2cssWriteBit; // I2CSS write protection bit
+  uint16_t endaRegister; // ENDAx - area end address. Area 4 always ends at the end of memory so has none (0)
+};
+
+static constexpr SF_ST25DV64KC_AREA_DESCRIPTOR SF_ST25DV64KC_AREAS[4] = {
+    {REG_RFA1SS, BIT_I2CSS_MEM1_READ, BIT_I2CSS_MEM1_WRITE, REG_ENDA1},
+    {REG_RFA2SS, BIT_I2CSS_MEM2_READ, BIT_I2CSS_MEM2_WRITE, REG_ENDA2},
+    {REG_RFA3SS, BIT_I2CSS_MEM3_READ, BIT_I2CSS_MEM3_WRITE, REG_ENDA3},
+    {REG_RFA4SS, BIT_I2CSS_MEM4_READ, BIT_I2CSS_MEM4_WRITE, 0}};
+
+// Compile-time access to a memory area descriptor. memoryArea ranges from 1 to 4.
+template <uint8_t memoryArea>
+struct SF_ST25DV64KC_AREA
+{
+  static_assert((memoryArea >= 1) && (memoryArea <= 4), "Memory area must be 1 to 4");
+  static constexpr uint16_t RFSS = SF_ST25DV64KC_AREAS[(memoryArea - 1) & 0x03].rfssRegister;
+  static constexpr uint8_t I2CSS_READ = SF_ST25DV64KC_AREAS[(memoryArea - 1) & 0x03].i2cssReadBit;
+  static constexpr uint8_t I2CSS_WRITE = SF_ST25DV64KC_AREAS[(memoryArea - 1) & 0x03].i2cssWriteBit;
+  static constexpr uint16_t ENDA = SF_ST25DV64KC_AREAS[(memoryArea - 1) & 0x03].endaRegister;
+};
+
 enum class SF_ST25DV64KC_ERROR
 {
   NONE,
@@ -166,7 +390,71 @@ enum class SF_ST25DV64KC_ERROR
   INVALID_MEMORY_AREA_PASSED,
   INVALID_MEMORY_AREA_SIZE,
   OUT_OF_MEMORY,
-  I2C_TRANSMISSION_ERROR
+  I2C_TRANSMISSION_ERROR,
+  EEPROM_ADDRESS_OUT_OF_RANGE,
+  EXCLUSIVE_WINDOW_EXPIRED,
+  MAILBOX_DISABLED,
+  MAILBOX_BUSY,
+  MAILBOX_MESSAGE_TOO_LONG,
+  MAILBOX_CRC_ERROR,
+  MAILBOX_SEQUENCE_ERROR,
+  RF_SWITCH_DISABLED // Keep NUM_ERROR_CODES in step if codes are added after this one
+};
+
+// The number of SF_ST25DV64KC_ERROR codes, including NONE
+static const uint8_t NUM_ERROR_CODES = (uint8_t)SF_ST25DV64KC_ERROR::RF_SWITCH_DISABLED + 1;
+
+// An entry in the error log. For I2C_TRANSMISSION_ERROR the transfer fields describe the transfer which failed,
+// otherwise they are zero
+struct SF_ST25DV64KC_ERROR_RECORD
+{
+  SF_ST25DV64KC_ERROR code = SF_ST25DV64KC_ERROR::NONE;
+  uint8_t deviceAddress = 0;    // 7-bit I2C address
+  uint16_t registerAddress = 0;
+  uint16_t length = 0;          // Bytes in the transfer
+  uint8_t retries = 0;          // Times the transfer was retried before giving up
+  unsigned long timestamp = 0;  // millis() when the error was reported
+};
+
+// begin() startup modes
+enum class SF_ST25DV64KC_STARTUP : uint8_t
+{
+  FAST,         // A single I2C address probe
+  VERIFIED,     // A single burst read of the identity registers (memory size, IC_REF, UID, revision) which is checked and cached
+  VERIFIED_WARM // As VERIFIED, then also read the mailbox state so the FTM cache is warm
+};
+
+// GPO events. Each value is the bit number of the event in IT_STS_Dyn
+enum class SF_ST25DV64KC_EVENT : uint8_t
+{
+  RF_USER,
+  RF_ACTIVITY,
+  RF_INTERRUPT,
+  FIELD_FALLING,
+  FIELD_RISING,
+  RF_PUT_MSG,
+  RF_GET_MSG,
+  RF_WRITE
+};
+static const uint8_t NUM_EVENTS = 8;
+
+// Operation scheduler priorities, most urgent first
+enum class SF_ST25DV64KC_PRIORITY : uint8_t
+{
+  URGENT, // e.g. mailbox replies, field events
+  NORMAL,
+  BULK // e.g. log uploads, full NDEF rewrites
+};
+static const uint8_t NUM_PRIORITIES = 3;
+
+// Why the mailbox RPC dispatcher answered a request with an error response
+enum class SF_ST25DV64KC_RPC_ERROR : uint8_t
+{
+  NONE,
+  UNKNOWN_OPCODE, // No handler is registered for the opcode
+  MALFORMED,      // The length byte does not match the message length
+  TOO_LONG,       // The request does not fit in the dispatcher's buffer
+  HANDLER_FAILED  // The handler returned SFE_ST25DV64KC_RPC_FAILED
 };
 
 enum class SF_ST25DV_RF_RW_PROTECTION
@@ -0,0 +1,119 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the register batch used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_Batch.h"
+
+void SFE_ST25DV64KC_Batch::clear()
+{
+  _numEntries = 0;
+  _overflow = false;
+}
+
+bool SFE_ST25DV64KC_Batch::modify(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask, const uint8_t bits)
+{
+  // Keep the entries sorted by address then register, merging with an existing entry for the same register
+  uint8_t i = 0;
+
+  while ((i < _numEntries) && ((_entries[i].address < address) || ((_entries[i].address == address) && (_entries[i].registerAddress < registerAddress))))
+    i++;
+
+  if ((i < _numEntries) && (_entries[i].address == address) && (_entries[i].registerAddress == registerAddress))
+  {
+    _entries[i].bits = (_entries[i].bits & ~bitMask) | (bits & bitMask);
+    _entries[i].bitMask |= bitMask;
+    return true;
+  }
+
+  if (_numEntries == SFE_ST25DV64KC_BATCH_SIZE)
+  {
+    _overflow = true;
+    return false;
+  }
+
+  for (uint8_t j = _numEntries; j > i; j--)
+    _entries[j] = _entries[j - 1];
+
+  _entries[i].address = address;
+  _entries[i].registerAddress = registerAddress;
+  _entries[i].bitMask = bitMask;
+  _entries[i].bits = bits & bitMask;
+  _numEntries++;
+
+  return true;
+}
+
+bool SFE_ST25DV64KC_Batch::commit()
+{
+  bool success = !_overflow;
+
+  if (_overflow)
+  {
+    _tag->reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+  }
+
+  uint8_t values[SFE_ST25DV64KC_BATCH_SIZE];
+  uint8_t runStart = 0;
+
+  while (runStart < _numEntries)
+  {
+    // Find the end of this run of contiguous registers
+    uint8_t runEnd = runStart + 1;
+    while ((runEnd < _numEntries) && (_entries[runEnd].address == _entries[runStart].address) && (_entries[runEnd].registerAddress == _entries[runEnd - 1].registerAddress + 1))
+      runEnd++;
+
+    uint8_t runLength = runEnd - runStart;
+
+    // Only read the run if at least one register is not being written completely
+    bool needsRead = false;
+    for (uint8_t i = runStart; i < runEnd; i++)
+      if (_entries[i].bitMask != 0xFF)
+        needsRead = true;
+
+    bool runSuccess = true;
+
+    if (needsRead)
+      runSuccess = _tag->st25_io.readMultipleBytes(_entries[runStart].address, _entries[runStart].registerAddress, &values[runStart], runLength);
+
+    // Neither the system area nor the dynamic registers can be written sequentially: the tag NACKs it.
+    // So each register which changes is written on its own
+    for (uint8_t i = runStart; runSuccess && (i < runEnd); i++)
+    {
+      uint8_t newValue = (needsRead ? (values[i] & ~_entries[i].bitMask) : 0) | _entries[i].bits;
+      if (needsRead && (newValue == values[i]))
+        continue; // Unchanged
+      values[i] = newValue;
+
+      // Static registers share one I2C security session across the whole batch
+      if (_entries[i].address == SF_ST25DV64KC_ADDRESS::SYSTEM)
+        runSuccess = _tag->writeSystemRegisters(_entries[i].registerAddress, &values[i], 1);
+      else
+        runSuccess = _tag->st25_io.writeSingleByte(_entries[i].address, _entries[i].registerAddress, values[i]);
+    }
+
+    success &= runSuccess;
+    runStart = runEnd;
+  }
+
+  if (!success && !_overflow)
+  {
+    _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+  }
+
+  clear();
+
+  return success;
+}
@@ -0,0 +1,95 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the register batch used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  A batch collects register read-modify-writes and commits them with as few I2C transactions as possible.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_BATCH_
+#define _SPARKFUN_ST25DV64KC_BATCH_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+
+// Maximum number of different registers which can be queued in one batch
+#define SFE_ST25DV64KC_BATCH_SIZE 8
+
+class SFE_ST25DV64KC_Batch
+{
+private:
+  struct batchEntry
+  {
+    SF_ST25DV64KC_ADDRESS address;
+    uint16_t registerAddress;
+    uint8_t bitMask; // The bits being changed. 0xFF means the whole register is written and does not need to be read
+    uint8_t bits;    // The new values of the bits in bitMask
+  };
+
+  SFE_ST25DV64KC *_tag;
+  batchEntry _entries[SFE_ST25DV64KC_BATCH_SIZE];
+  uint8_t _numEntries = 0;
+  bool _overflow = false;
+
+  static uint8_t combineFieldBits() { return 0; }
+  template <class Field, class... Fields>
+  static uint8_t combineFieldBits(Field field, Fields... fields) { return field.bits | combineFieldBits(fields...); }
+
+public:
+  // Begin a batch on tag
+  SFE_ST25DV64KC_Batch(SFE_ST25DV64KC &tag) : _tag(&tag){};
+
+  // Default destructor. Queued operations which have not been committed are discarded.
+  ~SFE_ST25DV64KC_Batch(){};
+
+  // Discard all queued operations and start again
+  void clear();
+
+  // Queue a read-modify-write of the bitMask bits of a register.
+  // Operations on a register which is already queued are merged into the existing entry.
+  // Returns false if the batch is full (see SFE_ST25DV64KC_BATCH_SIZE)
+  bool modify(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask, const uint8_t bits);
+
+  // Queue a write of a whole register
+  bool write(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t value) { return modify(address, registerAddress, 0xFF, value); }
+
+  // Queue setting or clearing the bitMask bits of a register
+  bool setRegisterBit(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask) { return modify(address, registerAddress, bitMask, bitMask); }
+  bool clearRegisterBit(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask) { return modify(address, registerAddress, bitMask, 0); }
+
+  // Queue a change of several typed fields of one register, e.g.
+  //   batch.modifyFields(FIELD_GPO1_GPO_EN(true), FIELD_GPO1_RF_USER_EN(true));
+  template <class... Fields>
+  bool modifyFields(Fields... fields)
+  {
+    static_assert(sizeof...(Fields) > 0, "At least one field is required");
+    static_assert(SF_ST25DV64KC_FIELDS<Fields...>::SAME_REGISTER, "All fields must belong to the same register");
+    static_assert(SF_ST25DV64KC_FIELDS<Fields...>::WRITABLE, "Read-only fields can not be written");
+    return modify(SF_ST25DV64KC_FIELDS<Fields...>::ADDRESS, SF_ST25DV64KC_FIELDS<Fields...>::REGISTER,
+                  SF_ST25DV64KC_FIELDS<Fields...>::MASK, combineFieldBits(fields...));
+  }
+
+  // Returns the number of different registers queued
+  uint8_t size() { return _numEntries; }
+
+  // Commit the batch:
+  //   Registers are sorted by address. Each run of contiguous registers which need reading is read with one burst;
+  //   the queued changes are applied and each register which changed is written with a single-byte write.
+  //   The tag NACKs sequential writes to the system area and to the dynamic registers, so they cannot be merged.
+  //   A register which was read and is unchanged is not written.
+  // The batch is empty afterwards.
+  // Returns true if every transfer succeeded. Calls the tag's error callback if a transfer fails or the batch overflowed.
+  bool commit();
+};
+
+#endif
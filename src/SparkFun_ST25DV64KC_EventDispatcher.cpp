@@ -0,0 +1,147 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the GPO event dispatcher used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_EventDispatcher.h"
+
+uint8_t SFE_ST25DV64KC_EventDispatcher::gpo1Bits(uint8_t itMask)
+{
+  // IT_STS_Dyn bits 0-2 are enabled by GPO1 bits 1-3, both field bits by FIELD_CHANGE_EN, and bits 5-7 by the same GPO1 bits
+  uint8_t bits = BIT_GPO1_GPO_EN;
+  bits |= (itMask & (BIT_IT_STS_DYN_RF_USER | BIT_IT_STS_DYN_RF_ACTIVITY | BIT_IT_STS_DYN_RF_INTERRUPT)) << 1;
+  if (itMask & (BIT_IT_STS_DYN_FIELD_FALLING | BIT_IT_STS_DYN_FIELD_RISING))
+    bits |= BIT_GPO1_FIELD_CHANGE_EN;
+  bits |= itMask & (BIT_IT_STS_DYN_RF_PUT_MSG | BIT_IT_STS_DYN_RF_GET_MSG | BIT_IT_STS_DYN_RF_WRITE);
+  return bits;
+}
+
+void SFE_ST25DV64KC_EventDispatcher::setEventHandler(SF_ST25DV64KC_EVENT event, void (*handler)(SF_ST25DV64KC_EVENT event))
+{
+  if ((uint8_t)event < NUM_EVENTS)
+    _handlers[(uint8_t)event] = handler;
+}
+
+bool SFE_ST25DV64KC_EventDispatcher::enableEvents()
+{
+  uint8_t itMask = 0;
+  for (uint8_t i = 0; i < NUM_EVENTS; i++)
+  {
+    if (_handlers[i] != nullptr)
+      itMask |= 1 << i;
+  }
+
+  // All eight bits are written, so the read is skipped. modifyRegisterBits reports its own errors
+  return _tag->modifyRegisterBits(SF_ST25DV64KC_ADDRESS::SYSTEM, REG_GPO1, 0xFF, gpo1Bits(itMask));
+}
+
+void SFE_ST25DV64KC_EventDispatcher::notify()
+{
+  _notified = true;
+  _notifications++;
+}
+
+uint8_t SFE_ST25DV64KC_EventDispatcher::service()
+{
+  if (!_notified)
+    return 0;
+
+  // Clear the flag before the read: an edge during the read sets it again and is picked up next time
+  _notified = false;
+
+  return readAndDispatch();
+}
+
+uint8_t SFE_ST25DV64KC_EventDispatcher::service(SFE_ST25DV64KC_EventQueue &queue)
+{
+  // _notified is set if a previous read failed
+  if (queue.isEmpty() && !_notified)
+    return 0;
+
+  _notified = false;
+
+  unsigned long timestamp;
+  uint8_t edges = 0;
+  bool first = true;
+  while (queue.pop(&timestamp))
+  {
+    if (first)
+      _batchStart = timestamp;
+    first = false;
+    if (edges < 255)
+      edges++;
+  }
+
+  if (edges > 0) // Keep the previous batch if this is just a retry
+  {
+    _batchEdges = edges;
+    noInterrupts();
+    _notifications += edges;
+    interrupts();
+  }
+
+  uint8_t itStatus = readAndDispatch();
+  _batchLatency = micros() - _batchStart;
+  return itStatus;
+}
+
+uint8_t SFE_ST25DV64KC_EventDispatcher::readAndDispatch()
+{
+  uint8_t itStatus;
+  bool success = _tag->st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::DATA, REG_IT_STS_DYN, &itStatus);
+  _busReads++;
+
+  if (!success)
+  {
+    _notified = true;
+    _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return 0;
+  }
+
+  dispatch(itStatus);
+  return itStatus;
+}
+
+void SFE_ST25DV64KC_EventDispatcher::dispatch(uint8_t itStatus)
+{
+  for (uint8_t i = 0; i < NUM_EVENTS; i++)
+  {
+    if (itStatus & (1 << i))
+    {
+      _eventCounts[i]++;
+      if (_handlers[i] != nullptr)
+        _handlers[i]((SF_ST25DV64KC_EVENT)i);
+    }
+  }
+}
+
+uint32_t SFE_ST25DV64KC_EventDispatcher::getNotifications()
+{
+  // A 32-bit read is not atomic on 8-bit processors
+  noInterrupts();
+  uint32_t notifications = _notifications;
+  interrupts();
+  return notifications;
+}
+
+void SFE_ST25DV64KC_EventDispatcher::resetStatistics()
+{
+  for (uint8_t i = 0; i < NUM_EVENTS; i++)
+    _eventCounts[i] = 0;
+  _busReads = 0;
+  noInterrupts();
+  _notifications = 0;
+  interrupts();
+}
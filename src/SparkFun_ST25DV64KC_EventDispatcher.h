@@ -0,0 +1,97 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the GPO event dispatcher used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  The GPO interrupt service routine calls notify(). service() is called from loop(): it reads IT_STS_Dyn once
+  (which clears it) and calls the handler registered for each event which is set.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_EVENT_DISPATCHER_
+#define _SPARKFUN_ST25DV64KC_EVENT_DISPATCHER_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+#include "SparkFun_ST25DV64KC_EventQueue.h"
+
+class SFE_ST25DV64KC_EventDispatcher
+{
+private:
+  SFE_ST25DV64KC *_tag;
+  void (*_handlers[NUM_EVENTS])(SF_ST25DV64KC_EVENT event) = {nullptr};
+  uint32_t _eventCounts[NUM_EVENTS] = {0};
+  uint32_t _busReads = 0;
+  uint8_t _batchEdges = 0;
+  unsigned long _batchStart = 0;
+  unsigned long _batchLatency = 0;
+
+  // Written by notify() in interrupt context
+  volatile bool _notified = false;
+  volatile uint32_t _notifications = 0;
+
+  // Returns the GPO1 value which enables GPO and the interrupts for the events in itMask
+  static uint8_t gpo1Bits(uint8_t itMask);
+
+  // Read IT_STS_Dyn once and dispatch it. If the read fails, the notification is kept
+  uint8_t readAndDispatch();
+
+public:
+  SFE_ST25DV64KC_EventDispatcher(SFE_ST25DV64KC &tag) : _tag(&tag) {}
+
+  // Register the handler for one event. Pass nullptr to remove it. One function can handle several events
+  void setEventHandler(SF_ST25DV64KC_EVENT event, void (*handler)(SF_ST25DV64KC_EVENT event));
+
+  // Write GPO1 so the GPO fires for the events which have a handler, and no others.
+  // FIELD_FALLING and FIELD_RISING share FIELD_CHANGE_EN.
+  // GPO1 is a static register: an I2C security session must be open, or a password set with setI2CSessionPassword.
+  bool enableEvents();
+
+  // Call from the GPO interrupt service routine. Does not touch the bus
+  void notify();
+
+  // Call from loop(). If the GPO has fired since the last call, IT_STS_Dyn is read once and dispatched.
+  // Several edges before service() runs are coalesced into that one read: IT_STS_Dyn holds every event since it was last read.
+  // Returns the IT_STS_Dyn value dispatched (zero if nothing was read). If the read fails, the notification is kept.
+  uint8_t service();
+
+  // Call from loop() when the interrupt service routine pushes into an event queue instead of calling notify().
+  // Every waiting edge is drained as one batch and IT_STS_Dyn is read once for the whole batch.
+  // Returns the IT_STS_Dyn value dispatched (zero if nothing was read)
+  uint8_t service(SFE_ST25DV64KC_EventQueue &queue);
+
+  // Call the handlers for the events set in an IT_STS_Dyn value which has already been read. Events are dispatched in bit order
+  void dispatch(uint8_t itStatus);
+
+  // Returns the number of times event has been dispatched
+  uint32_t getEventCount(SF_ST25DV64KC_EVENT event) { return _eventCounts[(uint8_t)event]; }
+
+  // Returns the number of times notify() has been called, plus the number of edges drained by service(queue)
+  uint32_t getNotifications();
+
+  // Returns the number of IT_STS_Dyn reads made on the bus
+  uint32_t getBusReads() { return _busReads; }
+
+  // Returns the number of edges in the last batch drained by service(queue)
+  uint8_t getBatchEdges() { return _batchEdges; }
+
+  // Returns the time (micros()) of the oldest edge in the last batch. Useful in a handler
+  unsigned long getBatchStart() { return _batchStart; }
+
+  // Returns the time (us) from the oldest edge in the last batch to the end of its dispatch
+  unsigned long getBatchLatency() { return _batchLatency; }
+
+  // Zero the event, notification and bus read counts
+  void resetStatistics();
+};
+
+#endif
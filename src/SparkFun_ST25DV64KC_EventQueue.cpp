@@ -0,0 +1,58 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the GPO event queue used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_EventQueue.h"
+
+bool SFE_ST25DV64KC_EventQueue::push()
+{
+  uint8_t head = _head;
+
+  if ((uint8_t)(head - _tail) >= SFE_ST25DV64KC_EVENT_QUEUE_SIZE)
+  {
+    if (_overflows < 255)
+      _overflows++;
+    return false;
+  }
+
+  // Fill the slot before publishing it by moving _head. The slots are not volatile, so the compiler
+  // barrier stops the store being moved after the _head write
+  _timestamps[head & (SFE_ST25DV64KC_EVENT_QUEUE_SIZE - 1)] = micros();
+  __asm__ __volatile__("" ::: "memory");
+  _head = head + 1;
+  return true;
+}
+
+bool SFE_ST25DV64KC_EventQueue::pop(unsigned long *timestamp)
+{
+  uint8_t tail = _tail;
+  uint8_t waiting = _head - tail;
+
+  if (waiting == 0)
+    return false;
+
+  if (waiting > _highWater)
+    _highWater = waiting;
+
+  // The barrier stops the slot being loaded before _head has been read...
+  __asm__ __volatile__("" ::: "memory");
+
+  // ...and the slot must be read before it is released by moving _tail
+  *timestamp = _timestamps[tail & (SFE_ST25DV64KC_EVENT_QUEUE_SIZE - 1)];
+  __asm__ __volatile__("" ::: "memory");
+  _tail = tail + 1;
+  return true;
+}
@@ -0,0 +1,68 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the GPO event queue used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  The queue is a lock-free single-producer / single-consumer ring: the GPO interrupt service routine pushes
+  the time of each edge, loop() pops them. Neither side disables interrupts.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_EVENT_QUEUE_
+#define _SPARKFUN_ST25DV64KC_EVENT_QUEUE_
+
+#include <Arduino.h> // The queue does not use the tag, so it can be included before - or without - the rest of the library
+
+// Number of GPO edges the queue can hold. Must be a power of two, no more than 128
+#ifndef SFE_ST25DV64KC_EVENT_QUEUE_SIZE
+#define SFE_ST25DV64KC_EVENT_QUEUE_SIZE 16
+#endif
+
+class SFE_ST25DV64KC_EventQueue
+{
+  static_assert((SFE_ST25DV64KC_EVENT_QUEUE_SIZE & (SFE_ST25DV64KC_EVENT_QUEUE_SIZE - 1)) == 0, "SFE_ST25DV64KC_EVENT_QUEUE_SIZE must be a power of two");
+  static_assert(SFE_ST25DV64KC_EVENT_QUEUE_SIZE <= 128, "SFE_ST25DV64KC_EVENT_QUEUE_SIZE must be no more than 128");
+
+private:
+  // Not volatile: push() and pop() order their slot accesses against _head and _tail with compiler barriers
+  unsigned long _timestamps[SFE_ST25DV64KC_EVENT_QUEUE_SIZE];
+
+  // Free-running indices. Single bytes, so reads and writes are atomic on every platform.
+  // _head is only written by push(), _tail only by pop()
+  volatile uint8_t _head = 0;
+  volatile uint8_t _tail = 0;
+
+  volatile uint8_t _overflows = 0; // Written by push()
+  uint8_t _highWater = 0;          // Written by pop()
+
+public:
+  // Call from the GPO interrupt service routine: record micros() as the time of the edge.
+  // Returns false (and counts an overflow) if the queue is full
+  bool push();
+
+  // Call from loop(): take the oldest edge. Returns false if the queue is empty
+  bool pop(unsigned long *timestamp);
+
+  // Returns the number of edges waiting
+  uint8_t available() { return (uint8_t)(_head - _tail); }
+
+  // Returns true if no edges are waiting
+  bool isEmpty() { return _head == _tail; }
+
+  // Returns the number of edges dropped because the queue was full. Saturates at 255
+  uint8_t getOverflows() { return _overflows; }
+
+  // Returns the most edges seen waiting by pop()
+  uint8_t getHighWater() { return _highWater; }
+};
+
+#endif
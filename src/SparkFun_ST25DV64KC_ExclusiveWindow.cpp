@@ -0,0 +1,88 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the exclusive I2C window used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_ExclusiveWindow.h"
+
+SFE_ST25DV64KC_ExclusiveWindow::SFE_ST25DV64KC_ExclusiveWindow(SFE_ST25DV64KC &tag, unsigned long maxHoldMillis)
+    : _tag(&tag), _maxHoldMillis(maxHoldMillis)
+{
+  // Remember RF_MNGT_Dyn so release() can put back exactly what was there (e.g. RF_SLEEP set by an outer window)
+  bool success = _tag->st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_RF_MNGT_DYN, &_rfMngt);
+
+  if (success && !(_rfMngt & BIT_RF_MNGT_DYN_RF_SLEEP))
+    success = _tag->st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_RF_MNGT_DYN, _rfMngt | BIT_RF_MNGT_DYN_RF_SLEEP);
+
+  if (!success)
+  {
+    _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return;
+  }
+
+  _startMicros = micros();
+  _open = true;
+}
+
+bool SFE_ST25DV64KC_ExclusiveWindow::expired()
+{
+  return _open && ((micros() - _startMicros) / 1000 > _maxHoldMillis);
+}
+
+bool SFE_ST25DV64KC_ExclusiveWindow::check()
+{
+  if (!_open)
+    return false;
+
+  if (!expired())
+    return true;
+
+  release();
+
+  _tag->reportError(SF_ST25DV64KC_ERROR::EXCLUSIVE_WINDOW_EXPIRED);
+
+  return false;
+}
+
+bool SFE_ST25DV64KC_ExclusiveWindow::release()
+{
+  if (!_open)
+    return true;
+
+  // Only write if this window set RF_SLEEP
+  bool success = true;
+  if (!(_rfMngt & BIT_RF_MNGT_DYN_RF_SLEEP))
+    success = _tag->st25_io.writeSingleByte(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_RF_MNGT_DYN, _rfMngt);
+
+  if (!success)
+  {
+    // Stay open so the destructor (or the next release) tries to restore RF again
+    _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
+
+  _heldMicros = micros() - _startMicros;
+  _open = false;
+
+  return true;
+}
+
+unsigned long SFE_ST25DV64KC_ExclusiveWindow::getHeldTime()
+{
+  if (_open)
+    return micros() - _startMicros;
+
+  return _heldMicros;
+}
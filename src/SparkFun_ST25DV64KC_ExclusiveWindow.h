@@ -0,0 +1,71 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the exclusive I2C window used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  While the window is open, RF is put to sleep (RF_MNGT_Dyn RF_SLEEP) so a sequence of I2C transactions
+  can not be interleaved with - or NACKed because of - RF transactions.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_EXCLUSIVE_WINDOW_
+#define _SPARKFUN_ST25DV64KC_EXCLUSIVE_WINDOW_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+
+// Default maximum time (ms) RF may be held asleep by an exclusive window
+#define SFE_ST25DV64KC_EXCLUSIVE_MAX_HOLD_MS 500
+
+class SFE_ST25DV64KC_ExclusiveWindow
+{
+private:
+  SFE_ST25DV64KC *_tag;
+  unsigned long _maxHoldMillis;
+  unsigned long _startMicros = 0;
+  unsigned long _heldMicros = 0;
+  uint8_t _rfMngt = 0; // RF_MNGT_Dyn value to restore
+  bool _open = false;
+
+public:
+  // Open the window: put RF to sleep. Check isOpen() to see if it worked.
+  // maxHoldMillis is the longest RF should be kept asleep. See check()
+  SFE_ST25DV64KC_ExclusiveWindow(SFE_ST25DV64KC &tag, unsigned long maxHoldMillis = SFE_ST25DV64KC_EXCLUSIVE_MAX_HOLD_MS);
+
+  // Close the window: restore RF
+  ~SFE_ST25DV64KC_ExclusiveWindow() { release(); }
+
+  // The window can not be copied: only one object may restore RF
+  SFE_ST25DV64KC_ExclusiveWindow(const SFE_ST25DV64KC_ExclusiveWindow &) = delete;
+  SFE_ST25DV64KC_ExclusiveWindow &operator=(const SFE_ST25DV64KC_ExclusiveWindow &) = delete;
+
+  // Returns true while RF is held asleep by this window
+  bool isOpen() { return _open; }
+
+  // Returns true if the window is open and has been held for longer than the maximum hold time
+  bool expired();
+
+  // Call between the operations of a long sequence.
+  // Returns true if the window is open and within its maximum hold time.
+  // If the maximum hold time has been exceeded, RF is restored, the error callback is called
+  // with EXCLUSIVE_WINDOW_EXPIRED and false is returned.
+  bool check();
+
+  // Restore RF now, instead of waiting for the destructor. Records the time the window was held.
+  // Returns true if RF was restored (or the window was not open). If the write fails the window stays open
+  bool release();
+
+  // Returns the time (us) the window has been held: so far if it is still open, or in total once released
+  unsigned long getHeldTime();
+};
+
+#endif
@@ -0,0 +1,121 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the RF field detector used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_FieldDetector.h"
+
+SFE_ST25DV64KC_FieldDetector::SFE_ST25DV64KC_FieldDetector(SFE_ST25DV64KC &tag, unsigned long fastIntervalMillis,
+                                                           unsigned long slowIntervalMillis)
+    : _tag(&tag), _fastIntervalMillis(fastIntervalMillis), _slowIntervalMillis(slowIntervalMillis)
+{
+}
+
+bool SFE_ST25DV64KC_FieldDetector::readField(bool *present)
+{
+  uint8_t ehCtrl;
+  bool success = _tag->st25_io.readSingleByte(SF_ST25DV64KC_ADDRESS::DATA, DYN_REG_EH_CTRL_DYN, &ehCtrl);
+  _busReads++;
+  _lastReadMicros = micros();
+
+  if (!success)
+  {
+    _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
+
+  *present = (ehCtrl & BIT_EH_CTRL_DYN_FIELD_ON) != 0;
+  return true;
+}
+
+bool SFE_ST25DV64KC_FieldDetector::beginInterrupt()
+{
+  // modifyFields reports its own errors
+  if (!_tag->modifyFields(FIELD_GPO1_GPO_EN(true), FIELD_GPO1_FIELD_CHANGE_EN(true)))
+    return false;
+
+  _interruptMode = true;
+  _notified = false;
+  return readField(&_fieldPresent);
+}
+
+bool SFE_ST25DV64KC_FieldDetector::beginPolling()
+{
+  _interruptMode = false;
+  _lastPollMillis = millis();
+  return readField(&_fieldPresent);
+}
+
+void SFE_ST25DV64KC_FieldDetector::notify()
+{
+  // Keep the timestamp of the first edge: that is when the field changed
+  if (!_notified)
+    _notifyMicros = micros();
+  _notified = true;
+}
+
+bool SFE_ST25DV64KC_FieldDetector::update()
+{
+  unsigned long since;
+
+  if (_interruptMode)
+  {
+    if (!_notified)
+      return false;
+
+    noInterrupts();
+    since = _notifyMicros;
+    _notified = false;
+    interrupts();
+  }
+  else
+  {
+    if (millis() - _lastPollMillis < getPollInterval())
+      return false;
+
+    _lastPollMillis = millis();
+    since = _lastReadMicros;
+  }
+
+  bool present;
+  if (!readField(&present))
+  {
+    // Keep the notification so the next update() tries again
+    if (_interruptMode)
+    {
+      noInterrupts();
+      _notifyMicros = since;
+      _notified = true;
+      interrupts();
+    }
+    return false;
+  }
+
+  // In interrupt mode, an on and off pair of edges seen by a single read leave the state unchanged
+  if (present == _fieldPresent)
+    return false;
+
+  _fieldPresent = present;
+  _lastLatency = _lastReadMicros - since;
+  _detections++;
+  return true;
+}
+
+void SFE_ST25DV64KC_FieldDetector::resetStatistics()
+{
+  _lastLatency = 0;
+  _busReads = 0;
+  _detections = 0;
+}
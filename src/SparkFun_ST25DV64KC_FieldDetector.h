@@ -0,0 +1,97 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the RF field detector used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  With GPO1 linked to an interrupt pin, the bus is only read when the GPO signals a field change.
+  Without it, EH_CTRL_Dyn FIELD_ON is polled: quickly while a field is present, slowly while idle.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_FIELD_DETECTOR_
+#define _SPARKFUN_ST25DV64KC_FIELD_DETECTOR_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+
+// Default polling intervals (ms) used when there is no GPO interrupt
+#define SFE_ST25DV64KC_FIELD_POLL_FAST_MS 20  // While a field is present: catch the field going away quickly
+#define SFE_ST25DV64KC_FIELD_POLL_SLOW_MS 250 // While idle: keep bus traffic low
+
+class SFE_ST25DV64KC_FieldDetector
+{
+private:
+  SFE_ST25DV64KC *_tag;
+  unsigned long _fastIntervalMillis;
+  unsigned long _slowIntervalMillis;
+
+  // Written by notify() in interrupt context
+  volatile bool _notified = false;
+  volatile unsigned long _notifyMicros = 0;
+
+  bool _interruptMode = false;
+  bool _fieldPresent = false;
+  unsigned long _lastPollMillis = 0;
+  unsigned long _lastReadMicros = 0;
+  unsigned long _lastLatency = 0;
+  uint32_t _busReads = 0;
+  uint32_t _detections = 0;
+
+  // Read EH_CTRL_Dyn FIELD_ON. Returns true if the read succeeded
+  bool readField(bool *present);
+
+public:
+  SFE_ST25DV64KC_FieldDetector(SFE_ST25DV64KC &tag,
+                               unsigned long fastIntervalMillis = SFE_ST25DV64KC_FIELD_POLL_FAST_MS,
+                               unsigned long slowIntervalMillis = SFE_ST25DV64KC_FIELD_POLL_SLOW_MS);
+
+  // Event-driven detection: enable GPO_EN and FIELD_CHANGE_EN in GPO1 and read the current field state.
+  // GPO1 is a static register: an I2C security session must be open, or a password set with setI2CSessionPassword.
+  // Call notify() from the interrupt service routine attached to the GPO pin.
+  bool beginInterrupt();
+
+  // Polled detection: no GPO pin is needed. Reads the current field state.
+  bool beginPolling();
+
+  // Call from the GPO interrupt service routine. Does not touch the bus
+  void notify();
+
+  // Call from loop(). In interrupt mode, FIELD_ON is read once per notification and never otherwise.
+  // In polling mode, FIELD_ON is read when the current poll interval has elapsed.
+  // Returns true if the field state has changed. Check fieldPresent() for the new state.
+  bool update();
+
+  // Returns the field state as of the last update()
+  bool fieldPresent() { return _fieldPresent; }
+
+  // Returns true if the detector is using the GPO interrupt
+  bool isInterruptMode() { return _interruptMode; }
+
+  // Returns the current poll interval (ms): fast while a field is present, slow while idle
+  unsigned long getPollInterval() { return _fieldPresent ? _fastIntervalMillis : _slowIntervalMillis; }
+
+  // Returns the latency (us) of the most recent detection.
+  // In interrupt mode: from notify() to the confirming read.
+  // In polling mode: from the previous read to the read which saw the change - an upper bound
+  unsigned long getLastLatency() { return _lastLatency; }
+
+  // Returns the number of FIELD_ON reads made on the bus
+  uint32_t getBusReads() { return _busReads; }
+
+  // Returns the number of field changes detected
+  uint32_t getDetections() { return _detections; }
+
+  // Zero the latency, bus read and detection counts
+  void resetStatistics();
+};
+
+#endif
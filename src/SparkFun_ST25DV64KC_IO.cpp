@@ -19,9 +19,13 @@
 #include "SparkFun_ST25DV64KC_IO.h"
 #include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
 
-bool SFE_ST2525DV64KC_IO::begin(TwoWire &i2cPort)
+bool SFE_ST2525DV64KC_IO::begin(TwoWire &i2cPort, bool probe)
 {
   _i2cPort = &i2cPort;
+
+  if (!probe)
+    return true;
+
   return isConnected();
 }
 
@@ -31,8 +35,32 @@ bool SFE_ST2525DV64KC_IO::isConnected()
   return _i2cPort->endTransmission() == 0;
 }
 
+bool SFE_ST2525DV64KC_IO::sendDeviceSelect(const SF_ST25DV64KC_ADDRESS address)
+{
+  startTransfer(address, 0, 0);
+
+  // If the IC is busy the device select code is NACK'd. Try up to maxRetries times, waiting retryDelay ms between tries.
+  for (uint8_t tries = 0; tries < maxRetries; tries++)
+  {
+    if (tries > 0)
+    {
+      delay(retryDelay);
+      lastTransfer.retries++;
+      retryCount++;
+    }
+
+    _i2cPort->beginTransmission(static_cast<int>(address));
+    if (_i2cPort->endTransmission() == 0)
+      return true;
+  }
+
+  return false;
+}
+
 bool SFE_ST2525DV64KC_IO::writeMultipleBytes(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *const buffer, uint16_t const packetLength)
 {
+  startTransfer(address, registerAddress, packetLength);
+
   // Split long writes up into multiple chunks
   uint16_t bytesWritten = 0;
 
@@ -72,17 +100,64 @@ bool SFE_ST2525DV64KC_IO::writeMultipleBytes(const SF_ST25DV64KC_ADDRESS address
       if (maxTries == 0)
         result = false;
       else
+      {
         delay(retryDelay);
+        lastTransfer.retries++;
+        retryCount++;
+      }
     }
   }
 
   return result;
 }
 
+bool SFE_ST2525DV64KC_IO::writeSingleTransaction(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t *buffer, const uint16_t packetLength)
+{
+  // Wire would drop the bytes which do not fit and send the rest, so check first
+  if ((uint32_t)packetLength + 2 > wireBufferLength)
+    return false;
+
+  startTransfer(address, registerAddress, packetLength);
+
+  // If the IC is busy the transmission is NACK'd. Try up to maxRetries times, waiting retryDelay ms between tries.
+  for (uint8_t tries = 0; tries < maxRetries; tries++)
+  {
+    if (tries > 0)
+    {
+      delay(retryDelay);
+      lastTransfer.retries++;
+      retryCount++;
+    }
+
+    _i2cPort->beginTransmission(static_cast<int>(address));
+    _i2cPort->write(static_cast<uint8_t>(registerAddress >> 8));
+    _i2cPort->write(static_cast<uint8_t>(registerAddress & 0xff));
+    for (uint16_t i = 0; i < packetLength; i++)
+      _i2cPort->write(buffer[i]);
+
+    if (_i2cPort->endTransmission() == 0)
+      return true;
+  }
+
+  return false;
+}
+
 bool SFE_ST2525DV64KC_IO::readMultipleBytes(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *const buffer, const uint16_t packetLength)
+{
+  return readChunks(address, registerAddress, buffer, packetLength, readWriteChunkSize);
+}
+
+bool SFE_ST2525DV64KC_IO::readBurst(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *const buffer, const uint16_t packetLength)
+{
+  return readChunks(address, registerAddress, buffer, packetLength, getBurstSize());
+}
+
+bool SFE_ST2525DV64KC_IO::readChunks(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *const buffer, const uint16_t packetLength, const uint16_t chunkSize)
 {
   bool success = true; // Return true if packetLength is zero
 
+  startTransfer(address, registerAddress, packetLength);
+
   // Split long reads up into multiple chunks
   uint16_t bytesRead = 0;
 
@@ -92,9 +167,9 @@ bool SFE_ST2525DV64KC_IO::readMultipleBytes(const SF_ST25DV64KC_ADDRESS address,
 
   while ((bytesRead < packetLength) && (maxTries > 0))
   {
-    uint8_t bytesToRead; // Read the data in chunks of readWriteChunkSize max
-    if ((packetLength - bytesRead) > ((uint16_t)readWriteChunkSize))
-      bytesToRead = readWriteChunkSize;
+    uint16_t bytesToRead; // Read the data in chunks of chunkSize max
+    if ((packetLength - bytesRead) > chunkSize)
+      bytesToRead = chunkSize;
     else
       bytesToRead = packetLength - bytesRead;
 
@@ -125,6 +200,11 @@ bool SFE_ST2525DV64KC_IO::readMultipleBytes(const SF_ST25DV64KC_ADDRESS address,
     {
       delay(retryDelay);
       maxTries--;
+      if (maxTries > 0)
+      {
+        lastTransfer.retries++;
+        retryCount++;
+      }
     }
   }
 
@@ -133,6 +213,8 @@ bool SFE_ST2525DV64KC_IO::readMultipleBytes(const SF_ST25DV64KC_ADDRESS address,
 
 bool SFE_ST2525DV64KC_IO::readSingleByte(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *value)
 {
+  startTransfer(address, registerAddress, 1);
+
   // If the IC is busy - e.g. completing a previous write - the I2C transmission is NACK'd and fails.
   // Try up to maxRetries times, waiting retryDelay ms between tries.
   uint8_t maxTries = maxRetries;
@@ -161,6 +243,11 @@ bool SFE_ST2525DV64KC_IO::readSingleByte(const SF_ST25DV64KC_ADDRESS address, co
     {
       delay(retryDelay);
       maxTries--;
+      if (maxTries > 0)
+      {
+        lastTransfer.retries++;
+        retryCount++;
+      }
     }
   }
 
@@ -169,6 +256,8 @@ bool SFE_ST2525DV64KC_IO::readSingleByte(const SF_ST25DV64KC_ADDRESS address, co
 
 bool SFE_ST2525DV64KC_IO::writeSingleByte(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t value)
 {
+  startTransfer(address, registerAddress, 1);
+
   // If the IC is busy - e.g. completing a previous write - the I2C transmission is NACK'd and fails.
   // Try up to maxRetries times, waiting retryDelay ms between tries.
   uint8_t maxTries = maxRetries;
@@ -191,6 +280,11 @@ bool SFE_ST2525DV64KC_IO::writeSingleByte(const SF_ST25DV64KC_ADDRESS address, c
     {
       delay(retryDelay);
       maxTries--;
+      if (maxTries > 0)
+      {
+        lastTransfer.retries++;
+        retryCount++;
+      }
     }
   }
 
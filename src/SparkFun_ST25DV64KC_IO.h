@@ -23,11 +23,39 @@
 #include <Wire.h>
 #include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
 
+// The size of the platform's Wire transmit buffer: the longest single I2C write, including the two address bytes.
+// Wire silently drops bytes beyond it. AVR: 32, ESP32 / ESP8266: 128. Unrecognised platforms get the AVR size.
+// Define it before the library is included if your platform is not recognised, or set st25_io.wireBufferLength
+#ifndef SFE_ST25DV64KC_WIRE_BUFFER_LENGTH
+#if defined(I2C_BUFFER_LENGTH)
+#define SFE_ST25DV64KC_WIRE_BUFFER_LENGTH I2C_BUFFER_LENGTH
+#elif defined(WIRE_BUFFER_SIZE)
+#define SFE_ST25DV64KC_WIRE_BUFFER_LENGTH WIRE_BUFFER_SIZE
+#elif defined(BUFFER_LENGTH)
+#define SFE_ST25DV64KC_WIRE_BUFFER_LENGTH BUFFER_LENGTH
+#else
+#define SFE_ST25DV64KC_WIRE_BUFFER_LENGTH 32
+#endif
+#endif
+
 class SFE_ST2525DV64KC_IO
 {
 private:
   TwoWire *_i2cPort;
 
+  // Read packetLength bytes in transactions of up to chunkSize bytes
+  bool readChunks(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *const buffer, const uint16_t packetLength, const uint16_t chunkSize);
+
+  // Record the start of a transfer in lastTransfer
+  void startTransfer(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint16_t length)
+  {
+    lastTransfer.address = address;
+    lastTransfer.registerAddress = registerAddress;
+    lastTransfer.length = length;
+    lastTransfer.retries = 0;
+    transferCount++;
+  }
+
 public:
   // Default constructor.
   SFE_ST2525DV64KC_IO(){};
@@ -37,15 +65,31 @@ public:
 
   // Define the I2C chunk size (the maximum number of bytes to be read/written in one transmission)
   uint8_t readWriteChunkSize = 32;
+  // The longest single I2C write the platform can send, including the two address bytes. Limits writeSingleTransaction and sizes readBurst
+  uint16_t wireBufferLength = SFE_ST25DV64KC_WIRE_BUFFER_LENGTH;
   const uint8_t maxRetries = 6;
   const uint8_t retryDelay = 5;
 
+  // The most recent transfer and how many times it was retried. Used to give errors some context
+  SF_ST25DV64KC_TRANSFER lastTransfer;
+
+  // Running totals of transfers and retries. Take the difference across a sequence of operations to find its retry rate
+  uint32_t transferCount = 0;
+  uint32_t retryCount = 0;
+
   // Starts two wire interface.
-  bool begin(TwoWire &wirePort);
+  // If probe is true, returns the result of isConnected(). Otherwise the port is recorded and true is returned.
+  bool begin(TwoWire &wirePort, bool probe = true);
 
   // Returns true if we get a reply from the I2C device.
   bool isConnected();
 
+  // Sends a device select code with no register address or data, e.g. RF_SWITCH_OFF / RF_SWITCH_ON.
+  // Retries like the write functions if the IC is busy. Returns true if the device select code was ACK'd.
+  // The RF_SWITCH codes are NACKed every time unless I2C_CFG.RF_SWITCHOFF_EN is set: check it first (SFE_ST25DV64KC::rfSwitchOff does)
+  // rather than spending the retries on a NACK which will never clear.
+  bool sendDeviceSelect(const SF_ST25DV64KC_ADDRESS address);
+
   // Since ST25DV64KC has two possible I2C addresses, the correct address must be passed to each corresponding
   // IO function so the proper area is addressed.
 
@@ -58,9 +102,21 @@ public:
   // Reads multiple bytes from a register into buffer uint8_t array.
   bool readMultipleBytes(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *const buffer, const uint16_t packetLength);
 
+  // Returns the most bytes readBurst reads in one transaction: wireBufferLength, but no more than 255
+  // because several Wire cores return the requestFrom count as a uint8_t
+  uint16_t getBurstSize() { return (wireBufferLength > 255) ? 255 : wireBufferLength; }
+
+  // Reads multiple bytes in as few transactions as the platform allows: up to getBurstSize() bytes each, rather than readWriteChunkSize.
+  // The Wire receive buffer is normally the same size as the transmit buffer
+  bool readBurst(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *const buffer, const uint16_t packetLength);
+
   // Writes multiple bytes to register from buffer uint8_t array.
   bool writeMultipleBytes(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, uint8_t *const buffer, const uint16_t packetLength);
 
+  // Writes packetLength bytes in one I2C transaction - e.g. a mailbox message, which the tag must receive in one piece.
+  // Returns false without writing if packetLength + 2 is more than wireBufferLength. Retries like writeMultipleBytes if the IC is busy.
+  bool writeSingleTransaction(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t *buffer, const uint16_t packetLength);
+
   // Sets a single bit in a specific register. Bit position ranges from 0 (lsb) to 7 (msb).
   bool setRegisterBit(const SF_ST25DV64KC_ADDRESS address, const uint16_t registerAddress, const uint8_t bitMask);
 
@@ -0,0 +1,143 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the outgoing mailbox queue used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_MailboxQueue.h"
+
+bool SFE_ST25DV64KC_MailboxQueue::post(const uint8_t *data, uint16_t length)
+{
+  if ((length == 0) || (length > SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE) || (_depth >= SFE_ST25DV64KC_MAILBOX_QUEUE_SLOTS))
+    return false;
+
+  // hostPutMessage would reject it later, and it would block the queue
+  if (length + 2 > _tag->st25_io.wireBufferLength)
+    return false;
+
+  SLOT *slot = &_slots[(_head + _depth) % SFE_ST25DV64KC_MAILBOX_QUEUE_SLOTS];
+  memcpy(slot->data, data, length);
+  slot->length = length;
+  slot->queuedAt = millis();
+
+  if (!_inFlight)
+    _kick = true; // Try the mailbox at the next service(), without waiting for the poll interval
+
+  _depth++;
+  if (_depth > _highWater)
+    _highWater = _depth;
+
+  return true;
+}
+
+void SFE_ST25DV64KC_MailboxQueue::onEvent(SF_ST25DV64KC_EVENT event)
+{
+  if ((event == SF_ST25DV64KC_EVENT::RF_GET_MSG) && !_collected)
+  {
+    _collected = true;
+    _collectedAt = millis();
+  }
+}
+
+void SFE_ST25DV64KC_MailboxQueue::retire(bool delivered, unsigned long now)
+{
+  unsigned long latency = now - _slots[_head].queuedAt;
+
+  if (delivered)
+  {
+    _lastLatency = latency;
+    if (latency > _maxLatency)
+      _maxLatency = latency;
+    _averageLatency += ((float)latency - _averageLatency) / (float)(_delivered + 1);
+    _delivered++;
+  }
+  else
+    _expired++;
+
+  _head = (_head + 1) % SFE_ST25DV64KC_MAILBOX_QUEUE_SLOTS;
+  _depth--;
+  _inFlight = false;
+
+  if (_onDelivery != nullptr)
+    _onDelivery(latency, delivered);
+}
+
+bool SFE_ST25DV64KC_MailboxQueue::service()
+{
+  if (!_inFlight && (_depth == 0))
+    return false;
+
+  unsigned long now = millis();
+  bool pollDue = (_pollInterval > 0) && (now - _lastPoll >= _pollInterval);
+
+  if (!_collected && !_kick && !pollDue)
+    return false;
+
+  _lastPoll = now;
+  _statusReads++;
+
+  SF_ST25DV64KC_MAILBOX_STATUS status;
+  if (!_tag->mailboxStatus(&status))
+    return false; // Keep _collected and _kick so the next call tries again
+
+  bool collected = _collected;
+  _collected = false;
+  _kick = false;
+
+  if (_inFlight)
+  {
+    // HOST_PUT_MSG clears when RF has read the message, or when the watchdog releases it unread (RF_MISS_MSG).
+    // HOST_MISS_MSG is about the other direction - an RF message I2C did not read - so it is ignored here
+    if ((status.ctrl & BIT_MB_CTRL_DYN_MB_EN) && (status.ctrl & BIT_MB_CTRL_DYN_HOST_PUT_MSG))
+      return false;
+
+    bool delivered = (status.ctrl & BIT_MB_CTRL_DYN_MB_EN) && !(status.ctrl & BIT_MB_CTRL_DYN_RF_MISS_MSG);
+    retire(delivered, collected ? _collectedAt : now);
+  }
+
+  if (_depth == 0)
+    return false;
+
+  // The mailbox is disabled, or RF has put a message which the host has not read yet
+  if (!(status.ctrl & BIT_MB_CTRL_DYN_MB_EN) || (status.ctrl & BIT_MB_CTRL_DYN_RF_PUT_MSG))
+    return false;
+
+  // The status has just been read, so hostPutMessage does not need to read it again
+  SLOT *slot = &_slots[_head];
+  if (!_tag->hostPutMessage(slot->data, slot->length, false))
+    return false;
+
+  _inFlight = true;
+  return true;
+}
+
+void SFE_ST25DV64KC_MailboxQueue::clear()
+{
+  _head = 0;
+  _depth = 0;
+  _inFlight = false;
+  _collected = false;
+  _kick = false;
+}
+
+void SFE_ST25DV64KC_MailboxQueue::resetStatistics()
+{
+  _delivered = 0;
+  _expired = 0;
+  _statusReads = 0;
+  _highWater = _depth;
+  _lastLatency = 0;
+  _maxLatency = 0;
+  _averageLatency = 0.0;
+}
@@ -0,0 +1,141 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the outgoing mailbox queue used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  The mailbox holds one message at a time. The queue holds the host's replies and puts the next one
+  in the mailbox as soon as RF has collected the previous one.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_MAILBOX_QUEUE_
+#define _SPARKFUN_ST25DV64KC_MAILBOX_QUEUE_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+
+// Number of messages the queue can hold, including the one in the mailbox
+#ifndef SFE_ST25DV64KC_MAILBOX_QUEUE_SLOTS
+#define SFE_ST25DV64KC_MAILBOX_QUEUE_SLOTS 4
+#endif
+
+// Largest message the queue can hold. hostPutMessage writes a message in one I2C transaction, so the default is the
+// longest message the platform's Wire buffer can send (SFE_ST25DV64KC_WIRE_BUFFER_LENGTH less the two address bytes), up to MAILBOX_SIZE.
+// Each slot holds a full message: define a smaller size to save RAM
+#ifndef SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE
+#if (SFE_ST25DV64KC_WIRE_BUFFER_LENGTH - 2) > 256
+#define SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE 256
+#else
+#define SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE (SFE_ST25DV64KC_WIRE_BUFFER_LENGTH - 2)
+#endif
+#endif
+
+#define SFE_ST25DV64KC_MAILBOX_QUEUE_POLL_MS 50 // Default interval between status reads while waiting for RF
+
+// Called once for each message, in the order they were posted. latency is the time (ms) from post() until RF collected the message.
+// delivered is false if the mailbox watchdog released the message before RF read it
+typedef void (*SF_ST25DV64KC_MAILBOX_DELIVERY)(unsigned long latency, bool delivered);
+
+class SFE_ST25DV64KC_MailboxQueue
+{
+private:
+  SFE_ST25DV64KC *_tag;
+
+  struct SLOT
+  {
+    uint8_t data[SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE];
+    uint16_t length;
+    unsigned long queuedAt;
+  };
+  SLOT _slots[SFE_ST25DV64KC_MAILBOX_QUEUE_SLOTS];
+  uint8_t _head = 0;  // The oldest message. While _inFlight, it is the one in the mailbox
+  uint8_t _depth = 0; // Messages held, including the one in flight
+  bool _inFlight = false;
+
+  // A status read is only made when one of these says it is worth it
+  bool _collected = false;        // RF_GET_MSG seen since the last status read...
+  unsigned long _collectedAt = 0; // ...and when (millis())
+  bool _kick = false;             // A message was posted to an idle queue
+  unsigned long _pollInterval = SFE_ST25DV64KC_MAILBOX_QUEUE_POLL_MS;
+  unsigned long _lastPoll = 0;
+
+  SF_ST25DV64KC_MAILBOX_DELIVERY _onDelivery = nullptr;
+
+  // Statistics
+  uint32_t _delivered = 0;
+  uint32_t _expired = 0;
+  uint32_t _statusReads = 0;
+  uint8_t _highWater = 0;
+  unsigned long _lastLatency = 0;
+  unsigned long _maxLatency = 0;
+  float _averageLatency = 0.0;
+
+  // The message in flight has left the mailbox. Record it and remove it from the queue
+  void retire(bool delivered, unsigned long now);
+
+public:
+  SFE_ST25DV64KC_MailboxQueue(SFE_ST25DV64KC &tag) : _tag(&tag) {}
+
+  // Copy a message into the queue. It is put in the mailbox by service().
+  // Returns false if the queue is full, or if length is zero, more than SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE
+  // or too long for hostPutMessage (st25_io.wireBufferLength - 2)
+  bool post(const uint8_t *data, uint16_t length);
+
+  // Feed GPO events to the queue, e.g. from an SFE_ST25DV64KC_EventDispatcher handler.
+  // RF_GET_MSG means RF has collected the message, so the next one can be put in the mailbox
+  void onEvent(SF_ST25DV64KC_EVENT event);
+
+  // Call from loop(). If RF_GET_MSG has been seen, a message has been posted to an idle queue, or the poll interval has passed,
+  // reads the mailbox status once: retires the message RF has collected and puts the next one in the mailbox.
+  // Returns true if a message was put in the mailbox
+  bool service();
+
+  // Set the interval (ms) between status reads while no event arrives. When RF_GET_MSG is fed to onEvent,
+  // this only needs to be short enough to notice messages released by the mailbox watchdog. Zero disables polling
+  void setPollInterval(unsigned long interval) { _pollInterval = interval; }
+  unsigned long getPollInterval() { return _pollInterval; }
+
+  // Set the function called as each message leaves the mailbox. nullptr to remove it
+  void setDeliveryCallback(SF_ST25DV64KC_MAILBOX_DELIVERY onDelivery) { _onDelivery = onDelivery; }
+
+  // Returns the number of messages held, including the one in the mailbox
+  uint8_t getDepth() { return _depth; }
+
+  // Returns the largest depth seen
+  uint8_t getHighWater() { return _highWater; }
+
+  // Returns true if a message is in the mailbox waiting for RF
+  bool inFlight() { return _inFlight; }
+
+  // Returns true if no messages are held
+  bool isEmpty() { return _depth == 0; }
+
+  // Discard every message held. A message already in the mailbox stays there, but is not tracked
+  void clear();
+
+  // Returns the number of messages RF has collected, and the number the mailbox watchdog released unread
+  uint32_t getDelivered() { return _delivered; }
+  uint32_t getExpired() { return _expired; }
+
+  // Returns the delivery latency (ms) - from post() until RF collected the message - of the last message, the largest and the average
+  unsigned long getLastLatency() { return _lastLatency; }
+  unsigned long getMaxLatency() { return _maxLatency; }
+  float getAverageLatency() { return _averageLatency; }
+
+  // Returns the number of mailbox status reads made
+  uint32_t getStatusReads() { return _statusReads; }
+
+  // Zero the statistics
+  void resetStatistics();
+};
+
+#endif
@@ -0,0 +1,183 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the mailbox request/response dispatcher used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_MailboxRPC.h"
+
+SFE_ST25DV64KC_MailboxRPC::ENTRY *SFE_ST25DV64KC_MailboxRPC::find(uint8_t opcode)
+{
+  for (uint8_t i = 0; i < _numHandlers; i++)
+  {
+    if (_handlers[i].opcode == opcode)
+      return &_handlers[i];
+  }
+  return nullptr;
+}
+
+bool SFE_ST25DV64KC_MailboxRPC::setHandler(uint8_t opcode, SF_ST25DV64KC_RPC_HANDLER handler, void *context)
+{
+  if ((opcode == SFE_ST25DV64KC_RPC_ERROR_OPCODE) || (handler == nullptr))
+    return false;
+
+  ENTRY *entry = find(opcode);
+  if (entry == nullptr)
+  {
+    if (_numHandlers >= SFE_ST25DV64KC_RPC_HANDLERS)
+      return false;
+    entry = &_handlers[_numHandlers++];
+  }
+
+  entry->opcode = opcode;
+  entry->handler = handler;
+  entry->context = context;
+  return true;
+}
+
+void SFE_ST25DV64KC_MailboxRPC::removeHandler(uint8_t opcode)
+{
+  ENTRY *entry = find(opcode);
+  if (entry == nullptr)
+    return;
+
+  *entry = _handlers[--_numHandlers]; // The order does not matter
+}
+
+uint8_t SFE_ST25DV64KC_MailboxRPC::getMaxResponse()
+{
+  // The response frame is written in one I2C transaction, so it must fit in the Wire buffer as well as in our buffer
+  uint16_t frame = SFE_ST25DV64KC_RPC_BUFFER_SIZE - LEN_MAILBOX_HEADER;
+  if (frame + 2 > _tag->st25_io.wireBufferLength)
+    frame = _tag->st25_io.wireBufferLength - 2;
+  if (frame > MAILBOX_SIZE)
+    frame = MAILBOX_SIZE;
+  if ((_outbox != nullptr) && (frame > SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE))
+    frame = SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE;
+
+  if (frame <= SFE_ST25DV64KC_RPC_FRAME_HEADER)
+    return 0;
+
+  frame -= SFE_ST25DV64KC_RPC_FRAME_HEADER;
+  return (frame > 0xFF) ? 0xFF : frame;
+}
+
+void SFE_ST25DV64KC_MailboxRPC::discard(uint16_t length)
+{
+  // hostReadMessageBurst has already read the first chunk
+  uint16_t offset = sizeof(_buffer);
+  if (offset > _tag->st25_io.getBurstSize())
+    offset = _tag->st25_io.getBurstSize();
+  offset -= LEN_MAILBOX_HEADER;
+
+  while (offset < length)
+  {
+    uint16_t chunk = length - offset;
+    if (chunk > sizeof(_buffer) - LEN_MAILBOX_HEADER)
+      chunk = sizeof(_buffer) - LEN_MAILBOX_HEADER;
+
+    if (!_tag->st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, MAILBOX_BASE + offset, _buffer + LEN_MAILBOX_HEADER, chunk))
+      return; // The request stays in the mailbox and is read again by the next service()
+    offset += chunk;
+  }
+}
+
+bool SFE_ST25DV64KC_MailboxRPC::respond(uint8_t bodyLength)
+{
+  uint8_t *frame = _buffer + LEN_MAILBOX_HEADER;
+  frame[1] = bodyLength;
+
+  if (_outbox != nullptr)
+  {
+    // The queue copies the frame, and puts it in the mailbox once any message ahead of it has been collected
+    if (!_outbox->post(frame, SFE_ST25DV64KC_RPC_FRAME_HEADER + bodyLength))
+    {
+      _postFailures++;
+      return false;
+    }
+    _outbox->service();
+    return true;
+  }
+
+  // RF's request has just been read, so the mailbox is empty: skip hostPutMessage's status read
+  if (!_tag->hostPutMessage(frame, SFE_ST25DV64KC_RPC_FRAME_HEADER + bodyLength, false))
+  {
+    _postFailures++;
+    return false;
+  }
+  return true;
+}
+
+bool SFE_ST25DV64KC_MailboxRPC::respondError(uint8_t opcode, SF_ST25DV64KC_RPC_ERROR error)
+{
+  uint8_t *frame = _buffer + LEN_MAILBOX_HEADER;
+  frame[0] = SFE_ST25DV64KC_RPC_ERROR_OPCODE;
+  frame[2] = opcode;
+  frame[3] = (uint8_t)error;
+
+  _lastError = error;
+  _errorResponses++;
+  return respond(2);
+}
+
+bool SFE_ST25DV64KC_MailboxRPC::service()
+{
+  uint32_t startTransfers = _tag->st25_io.transferCount;
+  uint16_t length;
+
+  if (!_tag->hostReadMessageBurst(_buffer, sizeof(_buffer), &length))
+  {
+    if (length == 0)
+      return false; // The read failed
+
+    // Too long for the buffer. The first chunk has been read, so the opcode is known
+    _requests++;
+    uint8_t opcode = _buffer[LEN_MAILBOX_HEADER];
+    discard(length);
+    respondError(opcode, SF_ST25DV64KC_RPC_ERROR::TOO_LONG);
+    _lastTransfers = _tag->st25_io.transferCount - startTransfers;
+    return true;
+  }
+
+  if (length == 0)
+    return false; // No request
+
+  _requests++;
+  _lastError = SF_ST25DV64KC_RPC_ERROR::NONE;
+
+  uint8_t *frame = _buffer + LEN_MAILBOX_HEADER;
+  uint8_t opcode = frame[0];
+
+  if ((length < SFE_ST25DV64KC_RPC_FRAME_HEADER) || (frame[1] != length - SFE_ST25DV64KC_RPC_FRAME_HEADER))
+    respondError(opcode, SF_ST25DV64KC_RPC_ERROR::MALFORMED);
+  else
+  {
+    ENTRY *entry = find(opcode);
+    if (entry == nullptr)
+      respondError(opcode, SF_ST25DV64KC_RPC_ERROR::UNKNOWN_OPCODE);
+    else
+    {
+      // The handler works on the body where it is, and writes its response over it
+      int16_t response = entry->handler(frame + SFE_ST25DV64KC_RPC_FRAME_HEADER, frame[1], getMaxResponse(), entry->context);
+
+      if ((response == SFE_ST25DV64KC_RPC_FAILED) || (response > getMaxResponse()))
+        respondError(opcode, SF_ST25DV64KC_RPC_ERROR::HANDLER_FAILED);
+      else if (response >= 0)
+        respond(response); // frame[0] still holds the opcode
+    }
+  }
+
+  _lastTransfers = _tag->st25_io.transferCount - startTransfers;
+  return true;
+}
@@ -0,0 +1,122 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the mailbox request/response dispatcher used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  A request is a one-byte opcode and a length-prefixed body. The dispatcher calls the handler registered for the opcode
+  and posts its response. Handlers work on the received buffer in place: nothing is copied.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_MAILBOX_RPC_
+#define _SPARKFUN_ST25DV64KC_MAILBOX_RPC_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+
+class SFE_ST25DV64KC_MailboxQueue; // See SparkFun_ST25DV64KC_MailboxQueue.h
+
+// Number of opcodes which can have a handler
+#ifndef SFE_ST25DV64KC_RPC_HANDLERS
+#define SFE_ST25DV64KC_RPC_HANDLERS 8
+#endif
+
+// Size of the receive buffer, including the two mailbox status bytes. Longer requests are answered with TOO_LONG
+#ifndef SFE_ST25DV64KC_RPC_BUFFER_SIZE
+#define SFE_ST25DV64KC_RPC_BUFFER_SIZE 64
+#endif
+
+#define SFE_ST25DV64KC_RPC_FRAME_HEADER 2 // Opcode and body length
+
+#define SFE_ST25DV64KC_RPC_ERROR_OPCODE 0xFF // Error responses: the body is the request opcode and an SF_ST25DV64KC_RPC_ERROR
+
+// Handler return values, other than a response length
+#define SFE_ST25DV64KC_RPC_FAILED -1      // Answer with a HANDLER_FAILED error response
+#define SFE_ST25DV64KC_RPC_NO_RESPONSE -2 // Post nothing
+
+// A request handler. body points at the request body in the receive buffer. The response body is written over it, in place,
+// and may be up to maxResponse bytes long. Return the response length, SFE_ST25DV64KC_RPC_FAILED or SFE_ST25DV64KC_RPC_NO_RESPONSE
+typedef int16_t (*SF_ST25DV64KC_RPC_HANDLER)(uint8_t *body, uint8_t length, uint8_t maxResponse, void *context);
+
+class SFE_ST25DV64KC_MailboxRPC
+{
+private:
+  SFE_ST25DV64KC *_tag;
+  SFE_ST25DV64KC_MailboxQueue *_outbox = nullptr;
+
+  struct ENTRY
+  {
+    uint8_t opcode;
+    SF_ST25DV64KC_RPC_HANDLER handler;
+    void *context;
+  };
+  ENTRY _handlers[SFE_ST25DV64KC_RPC_HANDLERS];
+  uint8_t _numHandlers = 0;
+
+  // MB_CTRL_Dyn, MB_LEN_Dyn, then the request: opcode, length, body. The response is built in the same place
+  uint8_t _buffer[SFE_ST25DV64KC_RPC_BUFFER_SIZE];
+
+  // Statistics
+  uint32_t _requests = 0;
+  uint32_t _errorResponses = 0;
+  uint32_t _postFailures = 0;
+  uint32_t _lastTransfers = 0;
+  SF_ST25DV64KC_RPC_ERROR _lastError = SF_ST25DV64KC_RPC_ERROR::NONE;
+
+  ENTRY *find(uint8_t opcode);
+
+  // Read and discard the rest of a request which does not fit in _buffer
+  void discard(uint16_t length);
+
+  // Post the frame at _buffer + LEN_MAILBOX_HEADER, through the outbox if there is one.
+  // Otherwise it is written straight to the mailbox: the status has just been read, so it is not read again
+  bool respond(uint8_t bodyLength);
+
+  // Post an error response for opcode
+  bool respondError(uint8_t opcode, SF_ST25DV64KC_RPC_ERROR error);
+
+public:
+  SFE_ST25DV64KC_MailboxRPC(SFE_ST25DV64KC &tag) : _tag(&tag) {}
+
+  // Post responses through outbox instead of writing them straight to the mailbox. Use this when the sketch also posts its own
+  // messages through the queue: a direct write would find the mailbox busy with a queued message, and the queue would lose track of it
+  SFE_ST25DV64KC_MailboxRPC(SFE_ST25DV64KC &tag, SFE_ST25DV64KC_MailboxQueue &outbox) : _tag(&tag), _outbox(&outbox) {}
+
+  // Register the handler for opcode, replacing any already registered. SFE_ST25DV64KC_RPC_ERROR_OPCODE is reserved.
+  // Returns false if all SFE_ST25DV64KC_RPC_HANDLERS entries are in use
+  bool setHandler(uint8_t opcode, SF_ST25DV64KC_RPC_HANDLER handler, void *context = nullptr);
+
+  // Remove the handler for opcode
+  void removeHandler(uint8_t opcode);
+
+  // Serve one request. Call on RF_PUT_MSG, or from loop(). The request is read with hostReadMessageBurst,
+  // handled in place, and the response posted with hostPutMessage - or copied into the outbox, which is serviced straight away.
+  // Returns true if a request was served
+  bool service();
+
+  // Returns the largest response body a handler may write: limited by the buffer, by st25_io.wireBufferLength
+  // and, with an outbox, by SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE
+  uint8_t getMaxResponse();
+
+  // Returns the number of requests served, the number answered with an error response, and the number of responses which could not be posted
+  uint32_t getRequests() { return _requests; }
+  uint32_t getErrorResponses() { return _errorResponses; }
+  uint32_t getPostFailures() { return _postFailures; }
+
+  // Returns the error response sent for the last request. NONE if it was handled
+  SF_ST25DV64KC_RPC_ERROR getLastError() { return _lastError; }
+
+  // Returns the number of I2C transfers the last request cost, from reading the request to posting the response
+  uint32_t getLastBusTransfers() { return _lastTransfers; }
+};
+
+#endif
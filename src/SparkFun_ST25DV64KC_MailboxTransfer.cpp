@@ -0,0 +1,322 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the mailbox transfer layer used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_MailboxTransfer.h"
+
+uint16_t SFE_ST25DV64KC_MailboxTransfer::crc16(const uint8_t *data, uint16_t length, uint16_t crc)
+{
+  for (uint16_t i = 0; i < length; i++)
+  {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+float SFE_ST25DV64KC_MailboxTransfer::throughput(uint16_t length, unsigned long start)
+{
+  unsigned long elapsed = millis() - start;
+  if (elapsed == 0)
+    elapsed = 1; // A transfer quicker than the millis() resolution
+  return (float)length * 1000.0 / (float)elapsed;
+}
+
+void SFE_ST25DV64KC_MailboxTransfer::receiveInto(uint8_t *buffer, uint16_t size)
+{
+  _rxBuffer = buffer;
+  _rxBufferSize = size;
+  _rxSink = nullptr;
+  _receiving = false;
+}
+
+void SFE_ST25DV64KC_MailboxTransfer::receiveTo(SF_ST25DV64KC_SEGMENT_SINK sink, void *context)
+{
+  _rxSink = sink;
+  _rxContext = context;
+  _rxBuffer = nullptr;
+  _receiving = false;
+}
+
+void SFE_ST25DV64KC_MailboxTransfer::rxAbort(SF_ST25DV64KC_ERROR error)
+{
+  _receiving = false;
+  if (error != SF_ST25DV64KC_ERROR::NONE)
+    _tag->reportError(error);
+}
+
+bool SFE_ST25DV64KC_MailboxTransfer::drain(uint16_t offset, uint16_t messageLength)
+{
+  uint8_t scratch[SFE_ST25DV64KC_SEGMENT_SINK_CHUNK];
+
+  while (offset < messageLength)
+  {
+    uint16_t length = messageLength - offset;
+    if (length > sizeof(scratch))
+      length = sizeof(scratch);
+
+    if (!_tag->st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, MAILBOX_BASE + offset, scratch, length))
+    {
+      _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+      return false;
+    }
+    offset += length;
+  }
+
+  return true;
+}
+
+bool SFE_ST25DV64KC_MailboxTransfer::readPayload(uint16_t length, uint16_t *crc)
+{
+  uint16_t address = MAILBOX_BASE + SFE_ST25DV64KC_SEGMENT_HEADER_SIZE;
+
+  if (_rxSink == nullptr)
+  {
+    // Straight into the caller's buffer: readMultipleBytes splits it into chunks
+    uint8_t *destination = _rxBuffer + _rxCount;
+    if (!_tag->st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, address, destination, length))
+    {
+      _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+      return false;
+    }
+    *crc = crc16(destination, length, *crc);
+    return true;
+  }
+
+  uint8_t scratch[SFE_ST25DV64KC_SEGMENT_SINK_CHUNK];
+  uint16_t done = 0;
+
+  while (done < length)
+  {
+    uint16_t chunk = length - done;
+    if (chunk > sizeof(scratch))
+      chunk = sizeof(scratch);
+
+    if (!_tag->st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, address + done, scratch, chunk))
+    {
+      _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+      return false;
+    }
+    *crc = crc16(scratch, chunk, *crc);
+
+    // A segment read again after an I2C error is only passed on from where the sink left off
+    uint16_t offset = _rxCount + done;
+    if (offset + chunk > _rxSunk)
+    {
+      uint16_t skip = (_rxSunk > offset) ? _rxSunk - offset : 0;
+      if (!_rxSink(offset + skip, scratch + skip, chunk - skip, _rxContext))
+      {
+        // The sink has had enough. Empty the mailbox so RF can carry on
+        drain(SFE_ST25DV64KC_SEGMENT_HEADER_SIZE + done + chunk, SFE_ST25DV64KC_SEGMENT_HEADER_SIZE + length);
+        rxAbort(SF_ST25DV64KC_ERROR::NONE);
+        return false;
+      }
+      _rxSunk = offset + chunk;
+    }
+    done += chunk;
+  }
+
+  return true;
+}
+
+bool SFE_ST25DV64KC_MailboxTransfer::receive()
+{
+  if ((_rxBuffer == nullptr) && (_rxSink == nullptr))
+    return false;
+
+  // MB_CTRL_Dyn, MB_LEN_Dyn and the segment header, in one burst
+  uint8_t header[LEN_MAILBOX_HEADER + SFE_ST25DV64KC_SEGMENT_HEADER_SIZE];
+  if (!_tag->st25_io.readMultipleBytes(SF_ST25DV64KC_ADDRESS::DATA, REG_MB_CTRL_DYN, header, sizeof(header)))
+  {
+    _tag->reportError(SF_ST25DV64KC_ERROR::I2C_TRANSMISSION_ERROR);
+    return false;
+  }
+
+  if (!(header[0] & BIT_MB_CTRL_DYN_RF_PUT_MSG))
+    return false; // No message from RF
+
+  uint16_t messageLength = (uint16_t)header[1] + 1;
+  const uint8_t *segment = header + LEN_MAILBOX_HEADER;
+
+  if (messageLength < SFE_ST25DV64KC_SEGMENT_HEADER_SIZE)
+  {
+    // Too short to be a segment. The burst has already read all of it
+    _sequenceErrors++;
+    rxAbort(SF_ST25DV64KC_ERROR::MAILBOX_SEQUENCE_ERROR);
+    return false;
+  }
+
+  uint8_t id = segment[0];
+  uint16_t sequence = (uint16_t)segment[1] | ((uint16_t)segment[2] << 8);
+  uint16_t total = (uint16_t)segment[3] | ((uint16_t)segment[4] << 8);
+  uint16_t expectedCRC = (uint16_t)segment[5] | ((uint16_t)segment[6] << 8);
+  uint16_t payloadLength = messageLength - SFE_ST25DV64KC_SEGMENT_HEADER_SIZE;
+
+  bool current = _receiving && (id == _rxID) && (total == _rxLength);
+
+  if (current && (sequence + 1 == _rxNextSequence))
+  {
+    // RF sent the last segment again. It has already been accepted
+    _duplicates++;
+    drain(SFE_ST25DV64KC_SEGMENT_HEADER_SIZE, messageLength);
+    return false;
+  }
+
+  if (sequence == 0)
+  {
+    // A new transfer. Any transfer in progress is abandoned
+    if ((_rxSink == nullptr) && (total > _rxBufferSize))
+    {
+      drain(SFE_ST25DV64KC_SEGMENT_HEADER_SIZE, messageLength);
+      rxAbort(SF_ST25DV64KC_ERROR::MAILBOX_MESSAGE_TOO_LONG);
+      return false;
+    }
+
+    // The first segment read again after an I2C error is not a new transfer: the sink has already been given part of it
+    if (!current || (_rxNextSequence != 0))
+      _rxSunk = 0;
+
+    _receiving = true;
+    _received = false;
+    _rxID = id;
+    _rxNextSequence = 0;
+    _rxLength = total;
+    _rxCount = 0;
+    _rxStart = millis();
+  }
+  else if (!current || (sequence != _rxNextSequence))
+  {
+    _sequenceErrors++;
+    drain(SFE_ST25DV64KC_SEGMENT_HEADER_SIZE, messageLength);
+    rxAbort(SF_ST25DV64KC_ERROR::MAILBOX_SEQUENCE_ERROR);
+    return false;
+  }
+
+  if (payloadLength > _rxLength - _rxCount)
+  {
+    _sequenceErrors++;
+    drain(SFE_ST25DV64KC_SEGMENT_HEADER_SIZE, messageLength);
+    rxAbort(SF_ST25DV64KC_ERROR::MAILBOX_SEQUENCE_ERROR);
+    return false;
+  }
+
+  // The CRC covers the header fields before it, then the payload
+  uint16_t crc = crc16(segment, SFE_ST25DV64KC_SEGMENT_HEADER_SIZE - 2);
+
+  // If the read fails, the segment stays in the mailbox and is read again by the next call
+  if (!readPayload(payloadLength, &crc))
+    return false;
+
+  if (crc != expectedCRC)
+  {
+    _crcErrors++;
+    rxAbort(SF_ST25DV64KC_ERROR::MAILBOX_CRC_ERROR);
+    return false;
+  }
+
+  _rxCount += payloadLength;
+  _rxNextSequence++;
+
+  if (_rxCount == _rxLength)
+  {
+    _receiving = false;
+    _received = true;
+    _rxThroughput = throughput(_rxLength, _rxStart);
+  }
+
+  return true;
+}
+
+uint16_t SFE_ST25DV64KC_MailboxTransfer::getSegmentPayloadSize()
+{
+  uint16_t size = SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE;
+  if (size + 2 > _tag->st25_io.wireBufferLength)
+    size = _tag->st25_io.wireBufferLength - 2;
+  if (size > MAILBOX_SIZE)
+    size = MAILBOX_SIZE;
+
+  return (size > SFE_ST25DV64KC_SEGMENT_HEADER_SIZE) ? size - SFE_ST25DV64KC_SEGMENT_HEADER_SIZE : 0;
+}
+
+bool SFE_ST25DV64KC_MailboxTransfer::send(const uint8_t *data, uint16_t length)
+{
+  if (_sending || (length == 0) || (getSegmentPayloadSize() == 0))
+    return false;
+
+  _txData = data;
+  _txLength = length;
+  _txQueued = 0;
+  _txSequence = 0;
+  _txID++;
+  _sending = true;
+  _sent = false;
+  _txExpiredAtStart = _outbox->getExpired();
+  _txStart = millis();
+
+  return true;
+}
+
+bool SFE_ST25DV64KC_MailboxTransfer::service()
+{
+  if (_sending)
+  {
+    // Keep the outbox full, so the next segment is ready the moment RF collects the one in the mailbox
+    uint16_t payloadSize = getSegmentPayloadSize();
+
+    while (_txQueued < _txLength)
+    {
+      uint16_t length = _txLength - _txQueued;
+      if (length > payloadSize)
+        length = payloadSize;
+
+      uint8_t segment[SFE_ST25DV64KC_MAILBOX_QUEUE_MESSAGE_SIZE];
+      segment[0] = _txID;
+      segment[1] = _txSequence & 0xFF;
+      segment[2] = _txSequence >> 8;
+      segment[3] = _txLength & 0xFF;
+      segment[4] = _txLength >> 8;
+      memcpy(segment + SFE_ST25DV64KC_SEGMENT_HEADER_SIZE, _txData + _txQueued, length);
+
+      uint16_t crc = crc16(segment, SFE_ST25DV64KC_SEGMENT_HEADER_SIZE - 2);
+      crc = crc16(segment + SFE_ST25DV64KC_SEGMENT_HEADER_SIZE, length, crc);
+      segment[5] = crc & 0xFF;
+      segment[6] = crc >> 8;
+
+      if (!_outbox->post(segment, SFE_ST25DV64KC_SEGMENT_HEADER_SIZE + length))
+        break; // The outbox is full
+
+      _txQueued += length;
+      _txSequence++;
+    }
+  }
+
+  bool posted = _outbox->service();
+
+  if (_sending)
+  {
+    if (_outbox->getExpired() != _txExpiredAtStart)
+      _sending = false; // The watchdog released a segment RF never read: the transfer is lost
+    else if ((_txQueued == _txLength) && _outbox->isEmpty())
+    {
+      _sending = false;
+      _sent = true;
+      _txThroughput = throughput(_txLength, _txStart);
+    }
+  }
+
+  return posted;
+}
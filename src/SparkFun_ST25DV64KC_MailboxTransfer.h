@@ -0,0 +1,146 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the mailbox transfer layer used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  A mailbox message holds at most 256 bytes. The transfer layer splits larger payloads into segments, each with
+  a header holding a transfer ID, sequence number, total length and CRC, and reassembles them at the other end.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_MAILBOX_TRANSFER_
+#define _SPARKFUN_ST25DV64KC_MAILBOX_TRANSFER_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+
+class SFE_ST25DV64KC_MailboxQueue; // See SparkFun_ST25DV64KC_MailboxQueue.h
+
+// Segment header. Multi-byte fields are little-endian:
+//   byte 0     transfer ID - the same for every segment of a transfer
+//   bytes 1-2  sequence number - 0 for the first segment
+//   bytes 3-4  total length of the payload being transferred
+//   bytes 5-6  CRC-16/CCITT-FALSE of bytes 0-4 and the segment payload
+#define SFE_ST25DV64KC_SEGMENT_HEADER_SIZE 7
+
+// Size of the buffer used to pass inbound data to a sink
+#define SFE_ST25DV64KC_SEGMENT_SINK_CHUNK 32
+
+// Receives inbound data in order. offset is the position of data in the payload.
+// Each offset is passed once, even if a segment has to be read again after an I2C error.
+// Return false to abort the transfer
+typedef bool (*SF_ST25DV64KC_SEGMENT_SINK)(uint16_t offset, const uint8_t *data, uint16_t length, void *context);
+
+class SFE_ST25DV64KC_MailboxTransfer
+{
+private:
+  SFE_ST25DV64KC *_tag;
+  SFE_ST25DV64KC_MailboxQueue *_outbox;
+
+  // Inbound
+  uint8_t *_rxBuffer = nullptr;
+  uint16_t _rxBufferSize = 0;
+  SF_ST25DV64KC_SEGMENT_SINK _rxSink = nullptr;
+  void *_rxContext = nullptr;
+  bool _receiving = false;
+  bool _received = false;
+  uint8_t _rxID = 0;
+  uint16_t _rxNextSequence = 0;
+  uint16_t _rxLength = 0; // The total length, from the segment headers
+  uint16_t _rxCount = 0;  // Bytes received so far
+  uint16_t _rxSunk = 0;   // Bytes passed to the sink so far. Can run ahead of _rxCount while a segment is read
+  unsigned long _rxStart = 0;
+  float _rxThroughput = 0.0;
+
+  // Outbound
+  const uint8_t *_txData = nullptr;
+  uint16_t _txLength = 0;
+  uint16_t _txQueued = 0; // Bytes handed to the outbox so far
+  uint16_t _txSequence = 0;
+  uint8_t _txID = 0;
+  bool _sending = false;
+  bool _sent = false;
+  uint32_t _txExpiredAtStart = 0;
+  unsigned long _txStart = 0;
+  float _txThroughput = 0.0;
+
+  // Statistics
+  uint32_t _crcErrors = 0;
+  uint32_t _sequenceErrors = 0;
+  uint32_t _duplicates = 0;
+
+  // Read and discard the mailbox from offset to the end of the message, so RF can put the next one
+  bool drain(uint16_t offset, uint16_t messageLength);
+
+  // Read the segment payload into the caller's buffer, or pass it to the sink. Updates crc
+  bool readPayload(uint16_t length, uint16_t *crc);
+
+  // Abort the inbound transfer and report error
+  void rxAbort(SF_ST25DV64KC_ERROR error);
+
+  // Bytes per second for length bytes moved since start (millis())
+  static float throughput(uint16_t length, unsigned long start);
+
+public:
+  // Outbound segments are posted through outbox, so they are put in the mailbox as soon as RF collects the previous one
+  SFE_ST25DV64KC_MailboxTransfer(SFE_ST25DV64KC &tag, SFE_ST25DV64KC_MailboxQueue &outbox) : _tag(&tag), _outbox(&outbox) {}
+
+  // Reassemble inbound transfers into buffer. A transfer longer than size is rejected with MAILBOX_MESSAGE_TOO_LONG
+  void receiveInto(uint8_t *buffer, uint16_t size);
+
+  // Pass inbound transfers to sink as each segment is read. Any length is accepted.
+  // The CRC of a segment is checked after its data has been passed on: a CRC error aborts the transfer
+  void receiveTo(SF_ST25DV64KC_SEGMENT_SINK sink, void *context = nullptr);
+
+  // Read a segment RF has put in the mailbox. Call on RF_PUT_MSG, or from loop().
+  // The mailbox status and segment header are read in one burst. Returns true if a segment was accepted
+  bool receive();
+
+  // Returns true while an inbound transfer is in progress, and true once one has been received in full
+  bool receiving() { return _receiving; }
+  bool received() { return _received; }
+
+  // Returns the total length of the current or last inbound transfer, and the number of bytes received so far
+  uint16_t getReceiveLength() { return _rxLength; }
+  uint16_t getReceivedCount() { return _rxCount; }
+
+  // Start sending data. data must stay valid until sending() returns false.
+  // Returns false if a transfer is already being sent, or length is zero
+  bool send(const uint8_t *data, uint16_t length);
+
+  // Call from loop(). Keeps the outbox topped up with segments and services it. Returns true if a segment was put in the mailbox
+  bool service();
+
+  // Returns true while an outbound transfer is in progress, and true once one has been collected by RF in full
+  bool sending() { return _sending; }
+  bool sent() { return _sent; }
+
+  // Abandon the outbound transfer. Segments already in the outbox are still sent
+  void cancelSend() { _sending = false; }
+
+  // Returns the payload carried by each outbound segment, which is limited by the outbox message size and st25_io.wireBufferLength
+  uint16_t getSegmentPayloadSize();
+
+  // Returns the end-to-end throughput (bytes per second) of the last complete transfer in each direction
+  float getReceiveThroughput() { return _rxThroughput; }
+  float getSendThroughput() { return _txThroughput; }
+
+  // Returns the number of segments rejected for a bad CRC or an unexpected sequence number, and the number of repeated segments ignored
+  uint32_t getCRCErrors() { return _crcErrors; }
+  uint32_t getSequenceErrors() { return _sequenceErrors; }
+  uint32_t getDuplicates() { return _duplicates; }
+
+  // CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF. Pass the previous result as crc to continue a CRC
+  static uint16_t crc16(const uint8_t *data, uint16_t length, uint16_t crc = 0xFFFF);
+};
+
+#endif
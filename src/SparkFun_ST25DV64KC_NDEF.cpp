@@ -133,7 +133,7 @@ bool SFE_ST25DV64KC_NDEF::writeNDEFEmpty(uint16_t *address)
 
   if (tagWrite == NULL)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+    reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
     return false; // Memory allocation failed
   }
 
@@ -216,7 +216,7 @@ bool SFE_ST25DV64KC_NDEF::writeNDEFURI(const char *uri, uint8_t idCode, uint16_t
 
   if (tagWrite == NULL)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+    reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
     return false; // Memory allocation failed
   }
 
@@ -320,7 +320,7 @@ bool SFE_ST25DV64KC_NDEF::writeNDEFURI(const char *uri, uint8_t idCode, uint16_t
         tagWrite = new uint8_t[newLen + 4];
         if (tagWrite == NULL)
         {
-          SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+          reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
           return false; // Memory allocation failed
         }
         tagPtr = tagWrite; // Reset tagPtr
@@ -545,7 +545,7 @@ bool SFE_ST25DV64KC_NDEF::readNDEFURI(char *theURI, uint16_t maxURILen, uint8_t
         payload = new uint8_t[payloadLength]; // Create storage for the payload
         if (payload == NULL)
         {
-          SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+          reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
           return false; // Memory allocation failed
         }
 
@@ -567,16 +567,18 @@ bool SFE_ST25DV64KC_NDEF::readNDEFURI(char *theURI, uint16_t maxURILen, uint8_t
         }
         else
         {
-          if (maxURILen > strlen(getURIPrefix(*payload))) // Is there enough room to hold the prefix?
+          uint8_t prefixLen = getURIPrefixLength(*payload); // A single table lookup
+
+          if (maxURILen > prefixLen) // Is there enough room to hold the prefix?
           {
-            strcpy(theURI, getURIPrefix(*payload)); // Copy the prefix
-            maxURILen -= strlen(getURIPrefix(*payload)); // Reduce maxURILen
+            copyURIPrefix(*payload, theURI); // Copy the prefix
+            maxURILen -= prefixLen; // Reduce maxURILen
 
             uint16_t theTextLen = payloadLength - 1;
             if (theTextLen <= (maxURILen - 1)) // Is there enough space left to store the URI?
             {
-              memcpy(&theURI[strlen(getURIPrefix(*payload))], payload + 1, theTextLen);
-              theURI[strlen(getURIPrefix(*payload)) + theTextLen] = 0; // NULL-terminate the text
+              memcpy(&theURI[prefixLen], payload + 1, theTextLen);
+              theURI[prefixLen + theTextLen] = 0; // NULL-terminate the text
               loopState = allDone;
             }
             else
@@ -609,122 +611,143 @@ bool SFE_ST25DV64KC_NDEF::readNDEFURI(char *theURI, uint16_t maxURILen, uint8_t
   }
 }
 
+// URI prefixes, indexed by URI identifier code. The text and the lengths are kept in flash (PROGMEM) so they use no RAM on AVR
+static const char uriPrefix00[] PROGMEM = "";
+static const char uriPrefix01[] PROGMEM = "http://www.";
+static const char uriPrefix02[] PROGMEM = "https://www.";
+static const char uriPrefix03[] PROGMEM = "http://";
+static const char uriPrefix04[] PROGMEM = "https://";
+static const char uriPrefix05[] PROGMEM = "tel:";
+static const char uriPrefix06[] PROGMEM = "mailto:";
+static const char uriPrefix07[] PROGMEM = "ftp://anonymous:anonymous@";
+static const char uriPrefix08[] PROGMEM = "ftp://ftp.";
+static const char uriPrefix09[] PROGMEM = "ftps://";
+static const char uriPrefix0A[] PROGMEM = "sftp://";
+static const char uriPrefix0B[] PROGMEM = "smb://";
+static const char uriPrefix0C[] PROGMEM = "nfs://";
+static const char uriPrefix0D[] PROGMEM = "ftp://";
+static const char uriPrefix0E[] PROGMEM = "dav://";
+static const char uriPrefix0F[] PROGMEM = "news:";
+static const char uriPrefix10[] PROGMEM = "telnet://";
+static const char uriPrefix11[] PROGMEM = "imap:";
+static const char uriPrefix12[] PROGMEM = "rtsp://";
+static const char uriPrefix13[] PROGMEM = "urn:";
+static const char uriPrefix14[] PROGMEM = "pop:";
+static const char uriPrefix15[] PROGMEM = "sip:";
+static const char uriPrefix16[] PROGMEM = "sips:";
+static const char uriPrefix17[] PROGMEM = "tftp:";
+static const char uriPrefix18[] PROGMEM = "btspp://";
+static const char uriPrefix19[] PROGMEM = "btl2cap://";
+static const char uriPrefix1A[] PROGMEM = "btgoep://";
+static const char uriPrefix1B[] PROGMEM = "tcpobex://";
+static const char uriPrefix1C[] PROGMEM = "irdaobex://";
+static const char uriPrefix1D[] PROGMEM = "file://";
+static const char uriPrefix1E[] PROGMEM = "urn:epc:id:";
+static const char uriPrefix1F[] PROGMEM = "urn:epc:tag:";
+static const char uriPrefix20[] PROGMEM = "urn:epc:pat:";
+static const char uriPrefix21[] PROGMEM = "urn:epc:raw:";
+static const char uriPrefix22[] PROGMEM = "urn:epc:";
+static const char uriPrefix23[] PROGMEM = "urn:nfc:";
+
+static const char *const uriPrefixTable[] PROGMEM = {
+    uriPrefix00, uriPrefix01, uriPrefix02, uriPrefix03, uriPrefix04, uriPrefix05,
+    uriPrefix06, uriPrefix07, uriPrefix08, uriPrefix09, uriPrefix0A, uriPrefix0B,
+    uriPrefix0C, uriPrefix0D, uriPrefix0E, uriPrefix0F, uriPrefix10, uriPrefix11,
+    uriPrefix12, uriPrefix13, uriPrefix14, uriPrefix15, uriPrefix16, uriPrefix17,
+    uriPrefix18, uriPrefix19, uriPrefix1A, uriPrefix1B, uriPrefix1C, uriPrefix1D,
+    uriPrefix1E, uriPrefix1F, uriPrefix20, uriPrefix21, uriPrefix22, uriPrefix23};
+
+static const uint8_t uriPrefixLength[] PROGMEM = {
+    sizeof(uriPrefix00) - 1, sizeof(uriPrefix01) - 1, sizeof(uriPrefix02) - 1, sizeof(uriPrefix03) - 1, sizeof(uriPrefix04) - 1, sizeof(uriPrefix05) - 1,
+    sizeof(uriPrefix06) - 1, sizeof(uriPrefix07) - 1, sizeof(uriPrefix08) - 1, sizeof(uriPrefix09) - 1, sizeof(uriPrefix0A) - 1, sizeof(uriPrefix0B) - 1,
+    sizeof(uriPrefix0C) - 1, sizeof(uriPrefix0D) - 1, sizeof(uriPrefix0E) - 1, sizeof(uriPrefix0F) - 1, sizeof(uriPrefix10) - 1, sizeof(uriPrefix11) - 1,
+    sizeof(uriPrefix12) - 1, sizeof(uriPrefix13) - 1, sizeof(uriPrefix14) - 1, sizeof(uriPrefix15) - 1, sizeof(uriPrefix16) - 1, sizeof(uriPrefix17) - 1,
+    sizeof(uriPrefix18) - 1, sizeof(uriPrefix19) - 1, sizeof(uriPrefix1A) - 1, sizeof(uriPrefix1B) - 1, sizeof(uriPrefix1C) - 1, sizeof(uriPrefix1D) - 1,
+    sizeof(uriPrefix1E) - 1, sizeof(uriPrefix1F) - 1, sizeof(uriPrefix20) - 1, sizeof(uriPrefix21) - 1, sizeof(uriPrefix22) - 1, sizeof(uriPrefix23) - 1};
+
+static_assert(sizeof(uriPrefixLength) == SFE_ST25DV_NDEF_URI_ID_CODE_URN_NFC + 1, "One URI prefix is needed for each identifier code");
+
+#if defined(__AVR__)
+// The size of this union is the size of the longest URI prefix, so the AVR RAM copy always fits
+union uriPrefixSizes
+{
+  char p00[sizeof(uriPrefix00)];
+  char p01[sizeof(uriPrefix01)];
+  char p02[sizeof(uriPrefix02)];
+  char p03[sizeof(uriPrefix03)];
+  char p04[sizeof(uriPrefix04)];
+  char p05[sizeof(uriPrefix05)];
+  char p06[sizeof(uriPrefix06)];
+  char p07[sizeof(uriPrefix07)];
+  char p08[sizeof(uriPrefix08)];
+  char p09[sizeof(uriPrefix09)];
+  char p0A[sizeof(uriPrefix0A)];
+  char p0B[sizeof(uriPrefix0B)];
+  char p0C[sizeof(uriPrefix0C)];
+  char p0D[sizeof(uriPrefix0D)];
+  char p0E[sizeof(uriPrefix0E)];
+  char p0F[sizeof(uriPrefix0F)];
+  char p10[sizeof(uriPrefix10)];
+  char p11[sizeof(uriPrefix11)];
+  char p12[sizeof(uriPrefix12)];
+  char p13[sizeof(uriPrefix13)];
+  char p14[sizeof(uriPrefix14)];
+  char p15[sizeof(uriPrefix15)];
+  char p16[sizeof(uriPrefix16)];
+  char p17[sizeof(uriPrefix17)];
+  char p18[sizeof(uriPrefix18)];
+  char p19[sizeof(uriPrefix19)];
+  char p1A[sizeof(uriPrefix1A)];
+  char p1B[sizeof(uriPrefix1B)];
+  char p1C[sizeof(uriPrefix1C)];
+  char p1D[sizeof(uriPrefix1D)];
+  char p1E[sizeof(uriPrefix1E)];
+  char p1F[sizeof(uriPrefix1F)];
+  char p20[sizeof(uriPrefix20)];
+  char p21[sizeof(uriPrefix21)];
+  char p22[sizeof(uriPrefix22)];
+  char p23[sizeof(uriPrefix23)];
+};
+#endif
+
 const char *SFE_ST25DV64KC_NDEF::getURIPrefix(uint8_t prefixCode)
 {
-  switch (prefixCode)
+  if (prefixCode > SFE_ST25DV_NDEF_URI_ID_CODE_URN_NFC)
+    return "";
+
+#if defined(__AVR__)
+  // Flash can not be read through a normal pointer on AVR: copy the prefix into RAM.
+  // The buffer is shared by all calls, so the prefix is only valid until the next call
+  static char prefix[sizeof(uriPrefixSizes)];
+  copyURIPrefix(prefixCode, prefix);
+  return prefix;
+#else
+  return (const char *)pgm_read_ptr(&uriPrefixTable[prefixCode]);
+#endif
+}
+
+uint8_t SFE_ST25DV64KC_NDEF::getURIPrefixLength(uint8_t prefixCode)
+{
+  if (prefixCode > SFE_ST25DV_NDEF_URI_ID_CODE_URN_NFC)
+    return 0;
+
+  return pgm_read_byte(&uriPrefixLength[prefixCode]);
+}
+
+uint8_t SFE_ST25DV64KC_NDEF::copyURIPrefix(uint8_t prefixCode, char *dest)
+{
+  uint8_t len = getURIPrefixLength(prefixCode);
+
+  if (len > 0)
   {
-    case SFE_ST25DV_NDEF_URI_ID_CODE_NONE:
-      return "";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_HTTP_WWW:
-      return "http://www.";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_HTTPS_WWW:
-      return "https://www.";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_HTTP:
-      return "http://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_HTTPS:
-      return "https://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_TEL:
-      return "tel:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_MAILTO:
-      return "mailto:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_FTP_ANON_ANON:
-      return "ftp://anonymous:anonymous@";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_FTP_FTP:
-      return "ftp://ftp.";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_FTPS:
-      return "ftps://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_SFTP:
-      return "sftp://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_SMB:
-      return "smb://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_NFS:
-      return "nfs://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_FTP:
-      return "ftp://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_DAV:
-      return "dav://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_NEWS:
-      return "news:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_TELNET:
-      return "telnet://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_IMAP:
-      return "imap:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_RTSP:
-      return "rtsp://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_URN:
-      return "urn:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_POP:
-      return "pop:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_SIP:
-      return "sip:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_SIPS:
-      return "sips:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_TFTP:
-      return "tftp:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_BTSPP:
-      return "btspp://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_BTL2CAP:
-      return "btl2cap://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_BTGOEP:
-      return "btgoep://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_TCPOBEX:
-      return "tcpobex://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_IRDAOBEX:
-      return "irdaobex://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_FILE:
-      return "file://";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_URN_EPC_ID:
-      return "urn:epc:id:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_URN_EPC_TAG:
-      return "urn:epc:tag:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_URN_EPC_PAT:
-      return "urn:epc:pat:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_URN_EPC_RAW:
-      return "urn:epc:raw:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_URN_EPC:
-      return "urn:epc:";
-      break;
-    case SFE_ST25DV_NDEF_URI_ID_CODE_URN_NFC:
-      return "urn:nfc:";
-      break;
-    default:
-      return "";
-      break;
+    const char *prefix = (const char *)pgm_read_ptr(&uriPrefixTable[prefixCode]);
+    for (uint8_t i = 0; i < len; i++)
+      dest[i] = pgm_read_byte(&prefix[i]);
   }
+
+  dest[len] = 0; // NULL-terminate the prefix
+
+  return len;
 }
 
 /*
@@ -807,7 +830,7 @@ bool SFE_ST25DV64KC_NDEF::writeNDEFWiFi(const char *ssid, const char *passwd, ui
 
   if (tagWrite == NULL)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+    reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
     return false; // Memory allocation failed
   }
 
@@ -1012,7 +1035,7 @@ bool SFE_ST25DV64KC_NDEF::writeNDEFWiFi(const char *ssid, const char *passwd, ui
         tagWrite = new uint8_t[newLen + 4];
         if (tagWrite == NULL)
         {
-          SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+          reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
           return false; // Memory allocation failed
         }
         tagPtr = tagWrite; // Reset tagPtr
@@ -1239,7 +1262,7 @@ bool SFE_ST25DV64KC_NDEF::readNDEFWiFi(char *ssid, uint16_t maxSsidLen, char *pa
         payload = new uint8_t[payloadLength]; // Create storage for the payload
         if (payload == NULL)
         {
-          SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+          reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
           return false; // Memory allocation failed
         }
 
@@ -1380,7 +1403,7 @@ bool SFE_ST25DV64KC_NDEF::writeNDEFText(const uint8_t *theText, uint16_t textLen
 
   if (tagWrite == NULL)
   {
-    SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+    reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
     return false; // Memory allocation failed
   }
 
@@ -1484,7 +1507,7 @@ bool SFE_ST25DV64KC_NDEF::writeNDEFText(const uint8_t *theText, uint16_t textLen
         tagWrite = new uint8_t[newLen + 4 - textLength]; // Deduct textLength because theText has not yet been written
         if (tagWrite == NULL)
         {
-          SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+          reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
           return false; // Memory allocation failed
         }
         tagPtr = tagWrite; // Reset tagPtr
@@ -1748,7 +1771,7 @@ bool SFE_ST25DV64KC_NDEF::readNDEFText(uint8_t *theText, uint16_t *textLen, uint
         payload = new uint8_t[payloadLength]; // Create storage for the payload
         if (payload == NULL)
         {
-          SAFE_CALLBACK(_errorCallback, SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
+          reportError(SF_ST25DV64KC_ERROR::OUT_OF_MEMORY);
           return false; // Memory allocation failed
         }
 
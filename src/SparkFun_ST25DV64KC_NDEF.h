@@ -28,6 +28,9 @@ class SFE_ST25DV64KC_NDEF : public SFE_ST25DV64KC
 private:
   uint16_t _ccFileLen = 8; // Record the length of the CC File - default to 8 bytes for the ST25DV64K
 
+  // Copy the URI Prefix text from flash into dest and NULL-terminate it. Returns the length of the prefix
+  uint8_t copyURIPrefix(uint8_t prefixCode, char *dest);
+
 public:
   // Default constructor.
   SFE_ST25DV64KC_NDEF(){};
@@ -64,9 +67,13 @@ public:
   // Returns true if successful, otherwise false
   bool readNDEFURI(char *theURI, uint16_t maxURILen, uint8_t recordNo = 1);
 
-  // Return the URI Prefix Code as text
+  // Return the URI Prefix Code as text. On AVR the text is copied from flash into a static buffer
+  // which is overwritten by the next call: print or copy it before calling again
   const char *getURIPrefix(uint8_t prefixCode);
 
+  // Return the length of the URI Prefix text, without reading the text
+  uint8_t getURIPrefixLength(uint8_t prefixCode);
+
   // Write an empty NDEF WiFi Record to user memory
   // If address is not NULL, start writing at *address, otherwise start at _ccFileLen
   // Returns true if successful, otherwise false
@@ -117,4 +124,36 @@ public:
   bool readNDEFText(uint8_t *theText, uint16_t *textLen, uint8_t recordNo = 1, char *language = NULL, uint16_t maxLanguageLen = 0);
 };
 
+// NDEF class preset for one ST25DV variant (04KC, 16KC or 64KC). This is a convenience wrapper: it presets the user memory size
+// and the CC File length from SF_ST25DV64KC_VARIANT_TRAITS, and writes the matching CC File. It is not a smaller or faster build -
+// the EEPROM bounds checks still use the run-time user memory size, which readDeviceIdentity (and so begin(VERIFIED))
+// replaces with the size read from the tag.
+template <SF_ST25DV64KC_VARIANT variant>
+class SFE_ST25DVxxKC_NDEF : public SFE_ST25DV64KC_NDEF
+{
+public:
+  typedef SF_ST25DV64KC_VARIANT_TRAITS<variant> traits;
+
+  SFE_ST25DVxxKC_NDEF()
+  {
+    _userMemorySize = traits::USER_MEMORY_SIZE;
+    setCCFileLen(traits::CC_FILE_LEN);
+  };
+
+  // Write the CC File which matches this variant
+  // Returns true if successful, otherwise false
+  bool writeCCFile()
+  {
+    if (traits::CC_FILE_LEN == 4)
+      return writeCCFile4Byte(traits::CC_FILE_1);
+    return writeCCFile8Byte(traits::CC_FILE_1, traits::CC_FILE_2);
+  }
+
+  // Returns true if the connected tag is this variant. Reads and caches the identity if needed.
+  bool isExpectedVariant() { return getVariant() == variant; }
+};
+
+typedef SFE_ST25DVxxKC_NDEF<SF_ST25DV64KC_VARIANT::ST25DV04KC> SFE_ST25DV04KC_NDEF;
+typedef SFE_ST25DVxxKC_NDEF<SF_ST25DV64KC_VARIANT::ST25DV16KC> SFE_ST25DV16KC_NDEF;
+
 #endif
@@ -0,0 +1,208 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the cooperative operation scheduler used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_OperationScheduler.h"
+
+bool SFE_ST25DV64KC_OperationScheduler::submit(SF_ST25DV64KC_PRIORITY priority, const OPERATION &operation)
+{
+  uint8_t p = (uint8_t)priority;
+  if ((p >= NUM_PRIORITIES) || (_count[p] >= SFE_ST25DV64KC_OPERATION_QUEUE_SIZE))
+    return false;
+
+  OPERATION &slot = _queues[p][(_head[p] + _count[p]) % SFE_ST25DV64KC_OPERATION_QUEUE_SIZE];
+  slot = operation;
+  slot.offset = 0;
+  slot.queuedAt = micros();
+  slot.started = false;
+  _count[p]++;
+  return true;
+}
+
+void SFE_ST25DV64KC_OperationScheduler::releaseFTM()
+{
+  if (!_holdingFTM)
+    return;
+
+  _tag->endBulkWrite();
+  _holdingFTM = false;
+}
+
+bool SFE_ST25DV64KC_OperationScheduler::writeEEPROM(SF_ST25DV64KC_PRIORITY priority, uint16_t baseAddress, uint8_t *data, uint16_t dataLength,
+                                                    SF_ST25DV64KC_OPERATION_DONE onDone, void *context)
+{
+  OPERATION operation = {KIND::WRITE, baseAddress, data, dataLength, 0, nullptr, onDone, context, 0, false};
+  return submit(priority, operation);
+}
+
+bool SFE_ST25DV64KC_OperationScheduler::readEEPROM(SF_ST25DV64KC_PRIORITY priority, uint16_t baseAddress, uint8_t *data, uint16_t dataLength,
+                                                   SF_ST25DV64KC_OPERATION_DONE onDone, void *context)
+{
+  OPERATION operation = {KIND::READ, baseAddress, data, dataLength, 0, nullptr, onDone, context, 0, false};
+  return submit(priority, operation);
+}
+
+bool SFE_ST25DV64KC_OperationScheduler::call(SF_ST25DV64KC_PRIORITY priority, SF_ST25DV64KC_OPERATION function, void *context,
+                                             SF_ST25DV64KC_OPERATION_DONE onDone)
+{
+  if (function == nullptr)
+    return false;
+
+  OPERATION operation = {KIND::CALL, 0, nullptr, 0, 0, function, onDone, context, 0, false};
+  return submit(priority, operation);
+}
+
+bool SFE_ST25DV64KC_OperationScheduler::run()
+{
+  uint8_t p = 0;
+  while ((p < NUM_PRIORITIES) && (_count[p] == 0))
+    p++;
+
+  if (p == NUM_PRIORITIES)
+    return false;
+
+  OPERATION &operation = _queues[p][_head[p]];
+
+  if (!operation.started)
+  {
+    operation.started = true;
+
+    // Operations at one priority start in order, so this is the (_completed[p] + 1)th delay
+    unsigned long waited = micros() - operation.queuedAt;
+    _lastDelay[p] = waited;
+    if (waited > _maxDelay[p])
+      _maxDelay[p] = waited;
+    _averageDelay[p] += ((float)waited - _averageDelay[p]) / (float)(_completed[p] + 1);
+
+    for (uint8_t lower = p + 1; lower < NUM_PRIORITIES; lower++)
+    {
+      if ((_count[lower] > 0) && _queues[lower][_head[lower]].started)
+      {
+        _preemptions++;
+        break;
+      }
+    }
+  }
+
+  bool success;
+  bool finished;
+
+  if (operation.kind == KIND::CALL)
+  {
+    // A call may use the mailbox, so give it Fast Transfer Mode back. A write it interrupted disables FTM again when it resumes
+    releaseFTM();
+    success = operation.function(*_tag, operation.context);
+    finished = true;
+  }
+  else
+  {
+    uint16_t chunk = operation.length - operation.offset;
+    if (chunk > _chunkSize)
+      chunk = _chunkSize;
+
+    success = true;
+
+    // writeEEPROM would clear and restore MB_MODE around every chunk: two session-gated system writes each time.
+    // Hold FTM off for the whole write instead, unless the caller already has a bulk write session open
+    if ((operation.kind == KIND::WRITE) && !_tag->bulkWriteActive())
+    {
+      success = _tag->beginBulkWrite();
+      _holdingFTM = success; // A failed beginBulkWrite opens no session
+    }
+
+    if (success)
+    {
+      if (operation.kind == KIND::WRITE)
+        success = _tag->writeEEPROM(operation.address + operation.offset, operation.data + operation.offset, chunk);
+      else
+        success = _tag->readEEPROM(operation.address + operation.offset, operation.data + operation.offset, chunk);
+    }
+
+    operation.offset += chunk;
+    finished = !success || (operation.offset >= operation.length);
+  }
+
+  if (finished)
+  {
+    if (operation.kind == KIND::WRITE)
+      releaseFTM();
+
+    // Remove the operation before calling onDone, so onDone can queue another
+    SF_ST25DV64KC_OPERATION_DONE onDone = operation.onDone;
+    void *context = operation.context;
+    _head[p] = (_head[p] + 1) % SFE_ST25DV64KC_OPERATION_QUEUE_SIZE;
+    _count[p]--;
+    _completed[p]++;
+
+    if (onDone != nullptr)
+      onDone(success, context);
+  }
+
+  return true;
+}
+
+void SFE_ST25DV64KC_OperationScheduler::runAll()
+{
+  while (run())
+    ;
+}
+
+bool SFE_ST25DV64KC_OperationScheduler::isIdle()
+{
+  for (uint8_t p = 0; p < NUM_PRIORITIES; p++)
+  {
+    if (_count[p] > 0)
+      return false;
+  }
+  return true;
+}
+
+uint8_t SFE_ST25DV64KC_OperationScheduler::getPending(SF_ST25DV64KC_PRIORITY priority)
+{
+  return ((uint8_t)priority < NUM_PRIORITIES) ? _count[(uint8_t)priority] : 0;
+}
+
+unsigned long SFE_ST25DV64KC_OperationScheduler::getLastQueueingDelay(SF_ST25DV64KC_PRIORITY priority)
+{
+  return ((uint8_t)priority < NUM_PRIORITIES) ? _lastDelay[(uint8_t)priority] : 0;
+}
+
+unsigned long SFE_ST25DV64KC_OperationScheduler::getMaxQueueingDelay(SF_ST25DV64KC_PRIORITY priority)
+{
+  return ((uint8_t)priority < NUM_PRIORITIES) ? _maxDelay[(uint8_t)priority] : 0;
+}
+
+float SFE_ST25DV64KC_OperationScheduler::getAverageQueueingDelay(SF_ST25DV64KC_PRIORITY priority)
+{
+  return ((uint8_t)priority < NUM_PRIORITIES) ? _averageDelay[(uint8_t)priority] : 0.0;
+}
+
+uint32_t SFE_ST25DV64KC_OperationScheduler::getCompleted(SF_ST25DV64KC_PRIORITY priority)
+{
+  return ((uint8_t)priority < NUM_PRIORITIES) ? _completed[(uint8_t)priority] : 0;
+}
+
+void SFE_ST25DV64KC_OperationScheduler::resetStatistics()
+{
+  for (uint8_t p = 0; p < NUM_PRIORITIES; p++)
+  {
+    _completed[p] = 0;
+    _lastDelay[p] = 0;
+    _maxDelay[p] = 0;
+    _averageDelay[p] = 0;
+  }
+  _preemptions = 0;
+}
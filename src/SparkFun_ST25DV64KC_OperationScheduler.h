@@ -0,0 +1,135 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the cooperative operation scheduler used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  Operations are queued by priority. EEPROM reads and writes are split into chunks, and run() does one chunk
+  at a time, so an urgent operation only waits for the chunk in progress - not for a whole bulk transfer.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_OPERATION_SCHEDULER_
+#define _SPARKFUN_ST25DV64KC_OPERATION_SCHEDULER_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+
+// Number of operations which can be queued at each priority
+#ifndef SFE_ST25DV64KC_OPERATION_QUEUE_SIZE
+#define SFE_ST25DV64KC_OPERATION_QUEUE_SIZE 4
+#endif
+
+// Default EEPROM chunk size (bytes): the longest an urgent operation has to wait is one chunk
+#define SFE_ST25DV64KC_OPERATION_CHUNK 32
+
+// An operation which is not an EEPROM read or write. Return true if it succeeded. It is run in one go
+typedef bool (*SF_ST25DV64KC_OPERATION)(SFE_ST25DV64KC &tag, void *context);
+
+// Called when an operation has finished
+typedef void (*SF_ST25DV64KC_OPERATION_DONE)(bool success, void *context);
+
+class SFE_ST25DV64KC_OperationScheduler
+{
+private:
+  SFE_ST25DV64KC *_tag;
+  uint16_t _chunkSize;
+
+  enum class KIND : uint8_t
+  {
+    READ,
+    WRITE,
+    CALL
+  };
+
+  struct OPERATION
+  {
+    KIND kind;
+    uint16_t address;
+    uint8_t *data;
+    uint16_t length;
+    uint16_t offset; // Bytes done so far
+    SF_ST25DV64KC_OPERATION function;
+    SF_ST25DV64KC_OPERATION_DONE onDone;
+    void *context;
+    unsigned long queuedAt; // micros()
+    bool started;
+  };
+
+  // One ring per priority
+  OPERATION _queues[NUM_PRIORITIES][SFE_ST25DV64KC_OPERATION_QUEUE_SIZE];
+  uint8_t _head[NUM_PRIORITIES] = {0};
+  uint8_t _count[NUM_PRIORITIES] = {0};
+
+  // True while the scheduler holds a bulk write session open for an EEPROM write
+  bool _holdingFTM = false;
+
+  // Statistics
+  uint32_t _completed[NUM_PRIORITIES] = {0};
+  unsigned long _lastDelay[NUM_PRIORITIES] = {0};
+  unsigned long _maxDelay[NUM_PRIORITIES] = {0};
+  float _averageDelay[NUM_PRIORITIES] = {0};
+  uint32_t _preemptions = 0;
+
+  // Add an operation to the back of its priority's queue. Returns false if the queue is full
+  bool submit(SF_ST25DV64KC_PRIORITY priority, const OPERATION &operation);
+
+  // End the bulk write session opened for an EEPROM write, restoring Fast Transfer Mode
+  void releaseFTM();
+
+public:
+  // chunkSize is the most bytes an EEPROM read or write transfers in one step
+  SFE_ST25DV64KC_OperationScheduler(SFE_ST25DV64KC &tag, uint16_t chunkSize = SFE_ST25DV64KC_OPERATION_CHUNK)
+      : _tag(&tag), _chunkSize(chunkSize == 0 ? 1 : chunkSize) {}
+
+  // Queue an EEPROM write. data must stay valid until onDone is called. Returns false if the queue is full
+  bool writeEEPROM(SF_ST25DV64KC_PRIORITY priority, uint16_t baseAddress, uint8_t *data, uint16_t dataLength,
+                   SF_ST25DV64KC_OPERATION_DONE onDone = nullptr, void *context = nullptr);
+
+  // Queue an EEPROM read. data must stay valid until onDone is called. Returns false if the queue is full
+  bool readEEPROM(SF_ST25DV64KC_PRIORITY priority, uint16_t baseAddress, uint8_t *data, uint16_t dataLength,
+                  SF_ST25DV64KC_OPERATION_DONE onDone = nullptr, void *context = nullptr);
+
+  // Queue any other operation, e.g. a mailbox read. function is passed context. Returns false if the queue is full
+  bool call(SF_ST25DV64KC_PRIORITY priority, SF_ST25DV64KC_OPERATION function, void *context = nullptr,
+            SF_ST25DV64KC_OPERATION_DONE onDone = nullptr);
+
+  // Call from loop(). Does one step - one EEPROM chunk, or one call - of the most urgent operation.
+  // Fast Transfer Mode is held off from the first chunk of an EEPROM write until it finishes, or until a call runs in between.
+  // Clearing MB_MODE empties the mailbox: a message in it when the write starts is lost.
+  // Returns true if a step was done, false if there was nothing to do
+  bool run();
+
+  // Run until every queue is empty
+  void runAll();
+
+  // Returns true if there is nothing queued
+  bool isIdle();
+
+  // Returns the number of operations queued at a priority, including one in progress
+  uint8_t getPending(SF_ST25DV64KC_PRIORITY priority);
+
+  // Queueing delay: the time (us) from an operation being queued to its first step
+  unsigned long getLastQueueingDelay(SF_ST25DV64KC_PRIORITY priority);
+  unsigned long getMaxQueueingDelay(SF_ST25DV64KC_PRIORITY priority);
+  float getAverageQueueingDelay(SF_ST25DV64KC_PRIORITY priority);
+
+  // Returns the number of operations finished at a priority, successfully or not
+  uint32_t getCompleted(SF_ST25DV64KC_PRIORITY priority);
+
+  // Returns the number of operations started while a less urgent operation was part way through
+  uint32_t getPreemptions() { return _preemptions; }
+
+  // Zero the statistics
+  void resetStatistics();
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file implements the RF-aware write scheduler used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SparkFun_ST25DV64KC_RFScheduler.h"
+
+void SFE_ST25DV64KC_RFScheduler::fieldRising(unsigned long now)
+{
+  if (_fieldPresent)
+    return;
+
+  _fieldPresent = true;
+  _sessionStart = now;
+  _lastActivity = now;
+}
+
+void SFE_ST25DV64KC_RFScheduler::fieldFalling(unsigned long now)
+{
+  if (!_fieldPresent)
+    return;
+
+  _fieldPresent = false;
+  _lastFieldOff = now;
+
+  unsigned long session = now - _sessionStart;
+  if (_sessions == 0)
+    _averageSession = session;
+  else
+    _averageSession = _averageSession - (_averageSession / 4) + (session / 4);
+  _sessions++;
+}
+
+void SFE_ST25DV64KC_RFScheduler::onEvent(SF_ST25DV64KC_EVENT event)
+{
+  unsigned long now = millis();
+
+  if (event == SF_ST25DV64KC_EVENT::FIELD_RISING)
+    fieldRising(now);
+  else if (event == SF_ST25DV64KC_EVENT::FIELD_FALLING)
+    fieldFalling(now);
+  else
+  {
+    fieldRising(now); // RF activity means there is a field, even if the rising edge was missed
+    _lastActivity = now;
+  }
+}
+
+void SFE_ST25DV64KC_RFScheduler::onField(bool present)
+{
+  if (present)
+    fieldRising(millis());
+  else
+    fieldFalling(millis());
+}
+
+bool SFE_ST25DV64KC_RFScheduler::idleWindowLikely()
+{
+  unsigned long now = millis();
+
+  if (!_fieldPresent)
+    return (_sessions == 0) || (now - _lastFieldOff >= SFE_ST25DV64KC_RF_IDLE_GUARD_MS);
+
+  // The field is present, but a phone left lying on the tag stops talking to it
+  return (now - _lastActivity >= SFE_ST25DV64KC_RF_QUIET_MS) && (now - _sessionStart > _averageSession);
+}
+
+unsigned long SFE_ST25DV64KC_RFScheduler::getTimeSinceFieldOff()
+{
+  if (_fieldPresent || (_sessions == 0))
+    return 0;
+
+  return millis() - _lastFieldOff;
+}
+
+bool SFE_ST25DV64KC_RFScheduler::defer(SF_ST25DV64KC_DEFERRED_WRITE write, void *context)
+{
+  for (uint8_t i = 0; i < _pending; i++)
+  {
+    if ((_slots[i].write == write) && (_slots[i].context == context))
+    {
+      _writesCoalesced++;
+      return true;
+    }
+  }
+
+  if (_pending >= SFE_ST25DV64KC_RF_SCHEDULER_SLOTS)
+    return false;
+
+  _slots[_pending].write = write;
+  _slots[_pending].context = context;
+  _slots[_pending].queuedAt = millis();
+  _pending++;
+  return true;
+}
+
+bool SFE_ST25DV64KC_RFScheduler::runOldest()
+{
+  uint32_t transfers = _tag->st25_io.transferCount;
+  uint32_t retries = _tag->st25_io.retryCount;
+
+  bool success = _slots[0].write(*_tag, _slots[0].context);
+
+  transfers = _tag->st25_io.transferCount - transfers;
+  retries = _tag->st25_io.retryCount - retries;
+  _transfers += transfers;
+  _retries += retries;
+  _writesRun++;
+  if (!success || (retries > 0))
+    _collisions++;
+
+  SLOT failed = _slots[0];
+
+  _pending--;
+  for (uint8_t i = 0; i < _pending; i++)
+    _slots[i] = _slots[i + 1];
+
+  if (!success)
+  {
+    // Move the failed write to the back so the others still get their turn. Restart its deferral:
+    // otherwise, once forced, it would be forced again by every run() and block the queue
+    failed.queuedAt = millis();
+    _slots[_pending++] = failed;
+  }
+
+  return success;
+}
+
+bool SFE_ST25DV64KC_RFScheduler::run()
+{
+  if (_pending == 0)
+    return false;
+
+  if (!idleWindowLikely())
+  {
+    if (millis() - _slots[0].queuedAt < SFE_ST25DV64KC_RF_MAX_DEFER_MS)
+      return false;
+    _writesForced++;
+  }
+
+  runOldest();
+  return true;
+}
+
+bool SFE_ST25DV64KC_RFScheduler::flush()
+{
+  // Each write is tried once. Writes which fail stay held, at the back
+  bool success = true;
+  uint8_t toRun = _pending;
+  while (toRun-- > 0)
+  {
+    if (!runOldest())
+      success = false;
+  }
+  return success;
+}
+
+float SFE_ST25DV64KC_RFScheduler::getCollisionRate()
+{
+  if (_writesRun == 0)
+    return 0.0;
+
+  return (float)_collisions / (float)_writesRun;
+}
+
+float SFE_ST25DV64KC_RFScheduler::getRetryRate()
+{
+  if (_transfers == 0)
+    return 0.0;
+
+  return (float)_retries / (float)_transfers;
+}
+
+void SFE_ST25DV64KC_RFScheduler::resetStatistics()
+{
+  _writesRun = 0;
+  _writesForced = 0;
+  _writesCoalesced = 0;
+  _collisions = 0;
+  _transfers = 0;
+  _retries = 0;
+}
@@ -0,0 +1,134 @@
+/*
+  This is a library written for the ST25DV64KC Dynamic RFID Tag.
+  SparkFun sells these at its website:
+  https://www.sparkfun.com/products/
+
+  Do you like this library? Help support open source hardware. Buy a board!
+
+  This file declares the RF-aware write scheduler used by the ST25DV64KC Dynamic RFID Tag Arduino Library.
+  The scheduler learns RF session timing from field and RF activity events, holds deferrable writes
+  (NDEF refreshes, log appends) and runs them when RF is likely to be idle, so they are not NACKed.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License
+  along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARKFUN_ST25DV64KC_RF_SCHEDULER_
+#define _SPARKFUN_ST25DV64KC_RF_SCHEDULER_
+
+#include "SparkFun_ST25DV64KC_Arduino_Library.h"
+#include "SparkFun_ST25DV64KC_Arduino_Library_Constants.h"
+
+// Number of deferred writes the scheduler can hold
+#ifndef SFE_ST25DV64KC_RF_SCHEDULER_SLOTS
+#define SFE_ST25DV64KC_RF_SCHEDULER_SLOTS 4
+#endif
+
+#define SFE_ST25DV64KC_RF_IDLE_GUARD_MS 250 // After the field goes away, wait this long: phones often re-read straight away
+#define SFE_ST25DV64KC_RF_QUIET_MS 500      // With the field present, RF is idle if there has been no activity for this long...
+                                            // ...and the session has already lasted longer than usual
+#define SFE_ST25DV64KC_RF_MAX_DEFER_MS 5000 // Run a write anyway once it has been deferred this long
+
+// A deferred write. Return true if it succeeded; false to have it tried again in the next idle window
+typedef bool (*SF_ST25DV64KC_DEFERRED_WRITE)(SFE_ST25DV64KC &tag, void *context);
+
+class SFE_ST25DV64KC_RFScheduler
+{
+private:
+  SFE_ST25DV64KC *_tag;
+
+  struct SLOT
+  {
+    SF_ST25DV64KC_DEFERRED_WRITE write;
+    void *context;
+    unsigned long queuedAt;
+  };
+  SLOT _slots[SFE_ST25DV64KC_RF_SCHEDULER_SLOTS];
+  uint8_t _pending = 0; // _slots[0] is the oldest
+
+  // What has been learned about RF sessions. Times are millis()
+  bool _fieldPresent = false;
+  unsigned long _sessionStart = 0;
+  unsigned long _lastFieldOff = 0;
+  unsigned long _lastActivity = 0;
+  unsigned long _averageSession = 0; // Exponentially weighted: each new session counts for a quarter
+  uint32_t _sessions = 0;
+
+  // Statistics
+  uint32_t _writesRun = 0;
+  uint32_t _writesForced = 0;
+  uint32_t _writesCoalesced = 0;
+  uint32_t _collisions = 0;
+  uint32_t _transfers = 0;
+  uint32_t _retries = 0;
+
+  void fieldRising(unsigned long now);
+  void fieldFalling(unsigned long now);
+
+  // Run _slots[0] and record its transfers and retries. If it succeeds, it is removed.
+  // If it fails, it is moved to the back and its deferral starts again, so it does not hold up the others
+  bool runOldest();
+
+public:
+  SFE_ST25DV64KC_RFScheduler(SFE_ST25DV64KC &tag) : _tag(&tag) {}
+
+  // Feed GPO events to the scheduler, e.g. from SFE_ST25DV64KC_EventDispatcher handlers.
+  // FIELD_RISING and FIELD_FALLING mark the start and end of a session. All other events count as RF activity
+  void onEvent(SF_ST25DV64KC_EVENT event);
+
+  // Feed the field state to the scheduler, e.g. from SFE_ST25DV64KC_FieldDetector
+  void onField(bool present);
+
+  // Returns true if RF is likely to be idle: no field for SFE_ST25DV64KC_RF_IDLE_GUARD_MS,
+  // or no RF activity for SFE_ST25DV64KC_RF_QUIET_MS in a session which has already lasted longer than average
+  bool idleWindowLikely();
+
+  // Hold a write until RF is likely to be idle. The same write and context are only held once,
+  // so several requests for an NDEF refresh become one. Returns false if all the slots are in use
+  bool defer(SF_ST25DV64KC_DEFERRED_WRITE write, void *context = nullptr);
+
+  // Call from loop(). Runs the oldest write if RF is likely to be idle, or if it has been deferred for SFE_ST25DV64KC_RF_MAX_DEFER_MS.
+  // A write which fails goes to the back, and is not forced again until it has waited SFE_ST25DV64KC_RF_MAX_DEFER_MS once more.
+  // Returns true if a write was run
+  bool run();
+
+  // Run every held write now, idle or not (e.g. before going to sleep). Returns false if any write failed
+  bool flush();
+
+  // Returns the number of writes being held
+  uint8_t getPending() { return _pending; }
+
+  // Returns the average RF session length (ms)
+  unsigned long getAverageSessionLength() { return _averageSession; }
+
+  // Returns the number of RF sessions seen
+  uint32_t getSessionCount() { return _sessions; }
+
+  // Returns the time (ms) since the field went away. Zero while the field is present
+  unsigned long getTimeSinceFieldOff();
+
+  // Returns true if the field was present at the last event
+  bool fieldPresent() { return _fieldPresent; }
+
+  // Returns the number of writes run, and of those, how many had to be forced outside an idle window
+  uint32_t getWritesRun() { return _writesRun; }
+  uint32_t getWritesForced() { return _writesForced; }
+
+  // Returns the number of defer() calls merged into a write which was already held
+  uint32_t getWritesCoalesced() { return _writesCoalesced; }
+
+  // Returns the fraction of writes which needed a retry or failed
+  float getCollisionRate();
+
+  // Returns the average number of retries per transfer made by the writes
+  float getRetryRate();
+
+  // Zero the write statistics. What has been learned about RF sessions is kept
+  void resetStatistics();
+};
+
+#endif